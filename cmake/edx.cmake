@@ -62,12 +62,53 @@ SOURCE_GROUP("Project Format"
 	    ${EDX_SOURCE_DIR}/edXProjectFile.cpp
 	    ${EDX_SOURCE_DIR}/edXWriter.cpp
 	    ${EDX_SOURCE_DIR}/edXReader.cpp
+	    ${EDX_SOURCE_DIR}/edXJsonSax.h
+	    ${EDX_SOURCE_DIR}/edXJsonSax.cpp
+	    ${EDX_SOURCE_DIR}/edXJsonWriter.h
+	    ${EDX_SOURCE_DIR}/edXJsonWriter.cpp
+	    ${EDX_SOURCE_DIR}/edXBinaryFormat.h
+	    ${EDX_SOURCE_DIR}/edXBinaryFormat.cpp
+	    ${EDX_SOURCE_DIR}/edXJsonSkim.h
+	    ${EDX_SOURCE_DIR}/edXJsonSkim.cpp
+	    ${EDX_SOURCE_DIR}/edXFileProbe.cpp
+	    ${EDX_SOURCE_DIR}/edXParallelLoad.cpp
+	    ${EDX_HEADER_DIR}/edXLazyProject.h
+	    ${EDX_SOURCE_DIR}/edXLazyProject.cpp
+	    ${EDX_HEADER_DIR}/edXFileIO.h
+	    ${EDX_SOURCE_DIR}/edXFileIO.cpp
+	    ${EDX_SOURCE_DIR}/edXCompression.h
+	    ${EDX_SOURCE_DIR}/edXCompression.cpp
+	    ${EDX_SOURCE_DIR}/edXHash.h
+)
+
+SOURCE_GROUP("Scene Data"
+	FILES
+	    ${EDX_HEADER_DIR}/edXAssetStore.h
+	    ${EDX_SOURCE_DIR}/edXAssetStore.cpp
+	    ${EDX_SOURCE_DIR}/edXAssetKernels.cpp
+	    ${EDX_HEADER_DIR}/edXSpatialIndex.h
+	    ${EDX_SOURCE_DIR}/edXSpatialIndex.cpp
+	    ${EDX_HEADER_DIR}/edXInternedString.h
+	    ${EDX_SOURCE_DIR}/edXInternedString.cpp
+	    ${EDX_HEADER_DIR}/edXUniqueId.h
+	    ${EDX_SOURCE_DIR}/edXUniqueId.cpp
+	    ${EDX_HEADER_DIR}/edXSharedJson.h
+	    ${EDX_SOURCE_DIR}/edXSharedJson.cpp
+	    ${EDX_HEADER_DIR}/edXPropertySchema.h
+	    ${EDX_SOURCE_DIR}/edXPropertySchema.cpp
+	    ${EDX_HEADER_DIR}/edXIdIndex.h
 )
 
 SOURCE_GROUP("Library Format"
 	FILES
 	    ${EDX_HEADER_DIR}/edXLibraryFile.h
 	    ${EDX_SOURCE_DIR}/edXLibraryFile.cpp
+	    ${EDX_HEADER_DIR}/edXObjectFacets.h
+	    ${EDX_SOURCE_DIR}/edXObjectFacets.cpp
+	    ${EDX_HEADER_DIR}/edXObjectSearch.h
+	    ${EDX_SOURCE_DIR}/edXObjectSearch.cpp
+	    ${EDX_HEADER_DIR}/edXLibraryCatalog.h
+	    ${EDX_SOURCE_DIR}/edXLibraryCatalog.cpp
 	    ${EDX_SOURCE_DIR}/edXLibraryWriter.cpp
 	    ${EDX_SOURCE_DIR}/edXLibraryReader.cpp
 )
@@ -114,10 +155,28 @@ TARGET_INCLUDE_DIRECTORIES(edX
 		${CMAKE_SOURCE_DIR}/edX/src
 )
 
+# Parallel project loading uses std::thread
+FIND_PACKAGE(Threads REQUIRED)
+
 TARGET_LINK_LIBRARIES(edX PRIVATE
 	nlohmann_json::nlohmann_json
+	Threads::Threads
 )
 
+# Link zstd only if it exists (optional dependency); without it compressed files are rejected
+IF (TARGET zstd::libzstd)
+    TARGET_LINK_LIBRARIES(edX PRIVATE zstd::libzstd)
+    TARGET_COMPILE_DEFINITIONS(edX PRIVATE EDX_HAS_ZSTD)
+ELSEIF(TARGET zstd::libzstd_shared)
+    TARGET_LINK_LIBRARIES(edX PRIVATE zstd::libzstd_shared)
+    TARGET_COMPILE_DEFINITIONS(edX PRIVATE EDX_HAS_ZSTD)
+ELSEIF(TARGET zstd::libzstd_static)
+    TARGET_LINK_LIBRARIES(edX PRIVATE zstd::libzstd_static)
+    TARGET_COMPILE_DEFINITIONS(edX PRIVATE EDX_HAS_ZSTD)
+ELSE()
+    MESSAGE(STATUS "zstd not found - compressed project and library files are disabled")
+ENDIF()
+
 # Link XPSceneryLib only if it exists (optional dependency)
 IF (TARGET XPSceneryLib::XPSceneryLib)
     TARGET_COMPILE_DEFINITIONS(edX PRIVATE HAVE_XPLIB)
@@ -0,0 +1,277 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXAssetStore.h
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <edX/config/edXConfig.h>
+#include <edX/include/edXProjectFile.h>
+#include <edX/include/edXPropertySchema.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    /**
+     * @brief Latitude/longitude rectangle with an altitude range
+     *
+     * Default constructed bounds are empty. A rectangle whose minLongitude is
+     * greater than its maxLongitude crosses the antimeridian.
+     */
+    struct EDX_API GeoBounds
+    {
+        double minLatitude = std::numeric_limits<double>::infinity();
+        double minLongitude = std::numeric_limits<double>::infinity();
+        double minAltitude = std::numeric_limits<double>::infinity();
+        double maxLatitude = -std::numeric_limits<double>::infinity();
+        double maxLongitude = -std::numeric_limits<double>::infinity();
+        double maxAltitude = -std::numeric_limits<double>::infinity();
+
+        [[nodiscard]] bool is_empty() const { return minLatitude > maxLatitude; }
+        [[nodiscard]] bool contains(double latitude, double longitude) const;
+    };
+
+    /**
+     * @brief Plane tangent to the earth at an origin, in metres east, north and up
+     *
+     * The same equirectangular plane the group transforms use: exact along
+     * the meridian and the origin's parallel, and within a few centimetres
+     * over an airport. Longitudes must lie within half a turn of the origin.
+     */
+    class EDX_API LocalFrame
+    {
+    public:
+        LocalFrame() : LocalFrame(0.0, 0.0) {}
+        LocalFrame(double originLatitude, double originLongitude, double originAltitude = 0.0);
+        explicit LocalFrame(const AirportInfo& airport) : LocalFrame(airport.datumLat, airport.datumLon) {}
+
+        [[nodiscard]] double latitude() const { return m_latitude; }
+        [[nodiscard]] double longitude() const { return m_longitude; }
+        [[nodiscard]] double altitude() const { return m_altitude; }
+
+        // Metres per degree along each axis
+        [[nodiscard]] double metres_per_degree_latitude() const { return m_metresPerDegreeLatitude; }
+        [[nodiscard]] double metres_per_degree_longitude() const { return m_metresPerDegreeLongitude; }
+
+        void to_enu(double lat, double lon, double alt, double& east, double& north, double& up) const;
+        void from_enu(double east, double north, double up, double& lat, double& lon, double& alt) const;
+
+    private:
+        double m_latitude;
+        double m_longitude;
+        double m_altitude;
+        double m_metresPerDegreeLatitude;
+        double m_metresPerDegreeLongitude;
+    };
+
+    /**
+     * @brief Structure-of-arrays copy of a project's assets
+     *
+     * Positions live in contiguous double columns so whole-scene sweeps touch
+     * only the bytes they need; flags, ids and properties are kept in columns
+     * of their own. Converts losslessly to and from std::vector<SceneAsset>.
+     *
+     * Properties named in a schema can also be promoted into typed columns
+     * (see promote_properties). Promoted values live only in those columns:
+     * properties() holds what is left of each blob, typed writes go through
+     * the set_property_* calls, and to_assets merges the two back together.
+     *
+     * With a local frame set, east/north/up columns relative to it are cached.
+     * update_enu() brings them up to date: in one batch after the frame
+     * changes, or just for the assets marked as moved. The kernels below mark
+     * what they move; direct edits through the position spans need
+     * invalidate_enu(). The const accessors only read, so threads may share a
+     * const store; they throw std::logic_error while an update is pending.
+     */
+    class EDX_API AssetStore
+    {
+    public:
+        enum Flag : uint8_t
+        {
+            Locked = 1 << 0,
+            Hidden = 1 << 1,
+            Selected = 1 << 2
+        };
+
+        AssetStore() = default;
+        explicit AssetStore(const std::vector<SceneAsset>& assets);
+        explicit AssetStore(std::vector<SceneAsset>&& assets);
+
+        // Rebuild the assets as structs
+        [[nodiscard]] std::vector<SceneAsset> to_assets() const;
+
+        // Copy the position columns back into matching assets (same size and order)
+        void write_positions(std::vector<SceneAsset>& assets) const;
+
+        void push_back(const SceneAsset& asset);
+        void push_back(SceneAsset&& asset);
+        void reserve(size_t count);
+        void clear();
+
+        [[nodiscard]] size_t size() const { return m_latitudes.size(); }
+        [[nodiscard]] bool empty() const { return m_latitudes.empty(); }
+
+        // Position columns
+        std::span<double> latitudes() { return m_latitudes; }
+        std::span<double> longitudes() { return m_longitudes; }
+        std::span<double> altitudes() { return m_altitudes; }
+        std::span<double> headings() { return m_headings; }
+        [[nodiscard]] std::span<const double> latitudes() const { return m_latitudes; }
+        [[nodiscard]] std::span<const double> longitudes() const { return m_longitudes; }
+        [[nodiscard]] std::span<const double> altitudes() const { return m_altitudes; }
+        [[nodiscard]] std::span<const double> headings() const { return m_headings; }
+
+        // Flag bits (see Flag) and the remaining per-asset data
+        std::span<uint8_t> flags() { return m_flags; }
+        [[nodiscard]] std::span<const uint8_t> flags() const { return m_flags; }
+        [[nodiscard]] const std::vector<std::string>& ids() const { return m_ids; }
+        [[nodiscard]] const std::vector<UniqueId>& unique_ids() const { return m_uniqueIds; }
+        [[nodiscard]] const std::vector<InternedString>& libraries() const { return m_libraries; }
+        [[nodiscard]] const std::vector<InternedString>& layer_ids() const { return m_layerIds; }
+        [[nodiscard]] const std::vector<InternedString>& group_ids() const { return m_groupIds; }
+
+        // Property blobs without the promoted keys; full_properties adds them back
+        [[nodiscard]] const std::vector<SharedJson>& properties() const { return m_properties; }
+        [[nodiscard]] SharedJson full_properties(size_t index) const;
+
+        // Move the schema keys of every asset's properties into typed columns,
+        // first returning any earlier schema's values to the blobs; an empty
+        // schema drops the columns. Blobs that shared a tree still do.
+        void promote_properties(PropertySchema schema);
+        [[nodiscard]] const PropertyColumns& property_columns() const { return m_propertyColumns; }
+
+        // Typed writes to promoted properties; the value replaces whatever the
+        // blob held under the key. Throws if the field has another type.
+        void set_property_bool(size_t index, size_t field, bool value);
+        void set_property_integer(size_t index, size_t field, int64_t value);
+        void set_property_number(size_t index, size_t field, double value);
+        void set_property_string(size_t index, size_t field, std::string_view value);
+        void erase_property(size_t index, size_t field);
+
+        // Cached local coordinates; the columns are empty without a frame
+        void set_local_frame(const LocalFrame& frame);
+        void clear_local_frame();
+        [[nodiscard]] const std::optional<LocalFrame>& local_frame() const { return m_frame; }
+        void update_enu();
+        [[nodiscard]] bool enu_current() const;
+        [[nodiscard]] std::span<const double> east() const { require_current_enu(); return m_east; }
+        [[nodiscard]] std::span<const double> north() const { require_current_enu(); return m_north; }
+        [[nodiscard]] std::span<const double> up() const { require_current_enu(); return m_up; }
+
+        // Mark positions as changed so their local coordinates are recomputed
+        void invalidate_enu() { m_enuStale = true; m_enuDirty.clear(); }
+        void invalidate_enu(std::span<const size_t> indices);
+
+    private:
+        template<typename Asset>
+        void append(Asset&& asset);
+
+        [[nodiscard]] std::vector<SharedJson> all_full_properties() const;
+        void drop_json_property(size_t index, size_t field);
+        void require_current_enu() const;
+
+        std::vector<double> m_latitudes;
+        std::vector<double> m_longitudes;
+        std::vector<double> m_altitudes;
+        std::vector<double> m_headings;
+        std::vector<uint8_t> m_flags;
+        std::vector<std::string> m_ids;
+        std::vector<UniqueId> m_uniqueIds;
+        std::vector<InternedString> m_libraries;
+        std::vector<InternedString> m_layerIds;
+        std::vector<InternedString> m_groupIds;
+        std::vector<SharedJson> m_properties;
+        PropertyColumns m_propertyColumns;
+
+        std::optional<LocalFrame> m_frame;
+        std::vector<double> m_east;
+        std::vector<double> m_north;
+        std::vector<double> m_up;
+        std::vector<size_t> m_enuDirty;
+        bool m_enuStale = false;
+    };
+
+    //////////////////////////////////////////////////////
+    // Position kernels
+    //////////////////////////////////////////////////////
+
+    // Bounds of all positions; empty for an empty store
+    [[nodiscard]] EDX_API GeoBounds compute_bounds(const AssetStore& store);
+
+    // Indices of the assets whose latitude/longitude lie in the rectangle (altitude is ignored)
+    [[nodiscard]] EDX_API std::vector<size_t> filter_in_bounds(const AssetStore& store, const GeoBounds& bounds);
+
+    // Offset every position in degrees (and metres for altitude). Longitudes wrap
+    // into [-180, 180) and latitudes are clamped to [-90, 90].
+    EDX_API void translate_positions(AssetStore& store, double latitudeDelta, double longitudeDelta, double altitudeDelta = 0.0);
+
+    // Add to every heading, keeping the result in [0, 360)
+    EDX_API void rotate_headings(AssetStore& store, double degrees);
+
+    // Scale latitude/longitude offsets from an origin by a factor. Longitude
+    // offsets are measured the short way round; results wrap and clamp like
+    // translate_positions.
+    EDX_API void scale_positions(AssetStore& store, double originLatitude, double originLongitude, double factor);
+
+    //////////////////////////////////////////////////////
+    // Group transforms
+    //////////////////////////////////////////////////////
+
+    // Selections are strictly ascending indices into the store. The transforms
+    // below throw std::invalid_argument for unsorted or repeated indices and
+    // std::out_of_range for indices past the end.
+    [[nodiscard]] EDX_API std::vector<size_t> select_layer(const AssetStore& store, const InternedString& layerId);
+    [[nodiscard]] EDX_API std::vector<size_t> select_group(const AssetStore& store, const InternedString& groupId);
+    [[nodiscard]] EDX_API std::vector<size_t> select_ids(const AssetStore& store, std::span<const std::string> ids);
+
+    // Assets with any of the flag bits set, e.g. AssetStore::Selected
+    [[nodiscard]] EDX_API std::vector<size_t> select_flagged(const AssetStore& store, uint8_t flags);
+
+    // The group transforms below work on a plane tangent to the earth, which
+    // keeps distances and angles true for groups up to tens of kilometres
+    // across. Selected longitudes must lie within half a turn of the origin.
+
+    // Move the selection rigidly by metres east, north and up
+    EDX_API void translate_metres(AssetStore& store, std::span<const size_t> selection, double east, double north, double up = 0.0);
+
+    // Rotate the selection clockwise (the sense of headings) about a point and
+    // add the angle to each heading
+    EDX_API void rotate_about(AssetStore& store, std::span<const size_t> selection, double originLatitude, double originLongitude, double degrees);
+
+    // Scale the selection's distances from a point; headings are unchanged
+    EDX_API void scale_about(AssetStore& store, std::span<const size_t> selection, double originLatitude, double originLongitude, double factor);
+
+    // Move every asset so it keeps its offset in metres from the old datum
+    // about the new one, as when AirportInfo::datumLat/datumLon change
+    EDX_API void rebase_datum(AssetStore& store, double oldLatitude, double oldLongitude, double newLatitude, double newLongitude);
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,217 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXFileIO.h
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include <edX/config/edXConfig.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    /**
+     * @brief How hard a save tries to reach stable storage before returning
+     */
+    enum class Durability : uint8_t
+    {
+        None,   ///< Atomic replace only; contents may still be in the OS cache after a power loss
+        Data,   ///< Sync the file contents before it replaces the target
+        Full    ///< Sync the contents and the directory entry of the rename
+    };
+
+    /**
+     * @brief Compression applied to saved JSON files
+     *
+     * Loaders detect compressed files by their magic bytes, so no option is
+     * needed to read them back.
+     */
+    enum class Compression : uint8_t
+    {
+        None,
+        Zstd    ///< Streaming zstd frame; requires a build with zstd support
+    };
+
+    /**
+     * @brief Options controlling how project and library files are written
+     */
+    struct EDX_API SaveOptions
+    {
+        // Indent with 4 spaces (matches json::dump(4)); false writes compact JSON
+        bool prettyPrint = true;
+
+        Durability durability = Durability::Data;
+
+        // Ignored by the binary (.edxb) writer, which is already compact
+        Compression compression = Compression::None;
+
+        // zstd level: 1 (fastest) to 19 (smallest); negative levels trade ratio for speed
+        int compressionLevel = 3;
+
+        // Write each distinct asset other-properties object once, in a top-level
+        // "Property-Table" array, and point assets at it with "other-properties-ref".
+        // Much smaller for property-heavy projects, but readers that predate the
+        // table ignore the references. The binary writer always uses a table.
+        bool propertyTable = false;
+
+        // Write assets along a Hilbert curve over their positions instead of in
+        // vector order, so neighbours sit together in the file. Compresses
+        // better and suits readers that load a region. Layers refer to assets
+        // by id, so nothing else changes. See EdxProject::sort_assets_spatially().
+        bool spatialOrder = false;
+
+        // Library files only: also write the object search index next to the
+        // file (see LibraryFile::search_index_path) so loading can skip building it
+        bool searchIndex = false;
+    };
+
+    // True if this build can read and write compressed files
+    EDX_API bool is_compression_available();
+
+    /**
+     * @brief Options controlling how project files are read
+     */
+    struct EDX_API LoadOptions
+    {
+        // Worker threads for parsing the Assets and Layers arrays; 1 parses on the
+        // calling thread, 0 uses one thread per hardware core
+        unsigned int threadCount = 1;
+    };
+
+    /**
+     * @brief Destination for serialized file data
+     *
+     * Writers batch their output and hand it to the sink in large blocks.
+     * Implementations report failures by throwing.
+     */
+    class EDX_API OutputSink
+    {
+    public:
+        virtual ~OutputSink() = default;
+
+        virtual void write(const char* data, size_t size) = 0;
+    };
+
+    /**
+     * @brief OutputSink that forwards to a std::ostream
+     */
+    class EDX_API StreamSink final : public OutputSink
+    {
+    public:
+        explicit StreamSink(std::ostream& stream) : m_stream(stream) { }
+
+        void write(const char* data, size_t size) override;
+
+    private:
+        std::ostream& m_stream;
+    };
+
+    /**
+     * @brief OutputSink that atomically replaces a file
+     *
+     * Output goes to a temporary file next to the target through a large
+     * user-space buffer. commit() flushes it, syncs according to the durability
+     * policy and renames it over the target, so readers (and a crash at any
+     * point) only ever see the old or the new file. A writer destroyed without
+     * commit() removes its temporary file and leaves the target untouched.
+     */
+    class EDX_API AtomicFileWriter final : public OutputSink
+    {
+    public:
+        static constexpr size_t DEFAULT_BUFFER_SIZE = 1024 * 1024;
+
+        // Throws std::runtime_error if the temporary file cannot be created
+        explicit AtomicFileWriter(std::filesystem::path targetPath, Durability durability = Durability::Data,
+                                  size_t bufferSize = DEFAULT_BUFFER_SIZE);
+        ~AtomicFileWriter() override;
+
+        AtomicFileWriter(const AtomicFileWriter&) = delete;
+        AtomicFileWriter& operator=(const AtomicFileWriter&) = delete;
+
+        void write(const char* data, size_t size) override;
+
+        // Flush, sync and move the temporary file into place. Throws on failure.
+        void commit();
+
+    private:
+        void flush_buffer();
+        void write_direct(const char* data, size_t size);
+        void close_file();
+
+        std::filesystem::path m_targetPath;
+        std::filesystem::path m_tempPath;
+        Durability m_durability;
+        std::vector<char> m_buffer;
+        size_t m_used = 0;
+        bool m_committed = false;
+
+        // Native handle: a file descriptor on POSIX, a HANDLE on Windows
+        intptr_t m_file = -1;
+    };
+
+    /**
+     * @brief Read-only view of a whole file held in one contiguous block
+     *
+     * The file is memory-mapped where the platform allows it; otherwise (or if
+     * mapping fails, e.g. on some network shares) it is read into an owned
+     * buffer with positioned reads. Either way data() stays valid for as long
+     * as the MappedFile is alive, so callers that keep string_views into the
+     * text should hold on to the shared_ptr returned by open().
+     */
+    class EDX_API MappedFile
+    {
+    public:
+        // Throws std::runtime_error if the file cannot be opened or read
+        [[nodiscard]] static std::shared_ptr<const MappedFile> open(const std::filesystem::path& filePath);
+
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        [[nodiscard]] const char* data() const { return m_data; }
+        [[nodiscard]] size_t size() const { return m_size; }
+        [[nodiscard]] std::string_view view() const { return {m_data, m_size}; }
+
+        // False when the contents were copied into memory instead of mapped
+        [[nodiscard]] bool is_mapped() const { return m_mapped; }
+
+    private:
+        MappedFile() = default;
+
+        const char* m_data = nullptr;
+        size_t m_size = 0;
+        bool m_mapped = false;
+        std::vector<char> m_buffer;
+    };
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
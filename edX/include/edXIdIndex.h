@@ -0,0 +1,231 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXIdIndex.h
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <edX/include/edXUniqueId.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    /**
+     * @brief Hash indexes from id and unique id to a position in a vector of items
+     *
+     * Used for EdxProject assets and LibraryFile objects; T needs std::string id
+     * and UniqueId uniqueId members. The owner keeps the index current through
+     * insert and erase, and it is rebuilt lazily otherwise. Direct edits to the
+     * vector are caught when they change its size or storage, or move an item
+     * that is looked up; changing an id in place needs invalidate(). Empty ids
+     * are not indexed. A copied index starts out invalid.
+     */
+    template<typename T>
+    class IdIndex
+    {
+    public:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        IdIndex() = default;
+        IdIndex(const IdIndex&) {}
+        IdIndex& operator=(const IdIndex&) { invalidate(); return *this; }
+
+        void invalidate() { m_valid = false; }
+        void rebuild(const std::vector<T>& items);
+
+        // Make room for count more entries, e.g. before a batch of inserts
+        void reserve(const std::vector<T>& items, size_t count);
+
+        // Position of the matching item, or npos
+        [[nodiscard]] size_t find_id(const std::vector<T>& items, const std::string& id);
+        [[nodiscard]] size_t find_unique_id(const std::vector<T>& items, const UniqueId& uniqueId);
+
+        // Append the item unless its id or unique id is taken; returns its position or npos
+        size_t insert(std::vector<T>& items, T&& item);
+
+        // Append without the duplicate check, for callers that have just looked
+        // up both ids with find_id and find_unique_id; returns its position
+        size_t append(std::vector<T>& items, T&& item);
+
+        // Remove the item at position by moving the last item into its place
+        void erase(std::vector<T>& items, size_t position);
+
+    private:
+        void ensure(const std::vector<T>& items);
+        template<typename Key>
+        size_t find(const std::vector<T>& items, const Key& key, Key T::* field, std::unordered_map<Key, size_t>& map);
+
+        std::unordered_map<std::string, size_t> m_byId;
+        std::unordered_map<UniqueId, size_t> m_byUniqueId;
+        const T* m_data = nullptr;
+        size_t m_size = 0;
+        bool m_valid = false;
+        bool m_hasDuplicates = false;
+    };
+
+    template<typename T>
+    void IdIndex<T>::rebuild(const std::vector<T>& items)
+    {
+        m_byId.clear();
+        m_byUniqueId.clear();
+        m_byId.reserve(items.size());
+        m_byUniqueId.reserve(items.size());
+        m_hasDuplicates = false;
+
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            // The first item with a given id wins, like a linear scan
+            if (!items[i].id.empty() && !m_byId.emplace(items[i].id, i).second)
+                m_hasDuplicates = true;
+
+            if (!items[i].uniqueId.empty() && !m_byUniqueId.emplace(items[i].uniqueId, i).second)
+                m_hasDuplicates = true;
+        }
+
+        m_data = items.data();
+        m_size = items.size();
+        m_valid = true;
+    }
+
+    template<typename T>
+    void IdIndex<T>::reserve(const std::vector<T>& items, const size_t count)
+    {
+        ensure(items);
+        m_byId.reserve(m_byId.size() + count);
+        m_byUniqueId.reserve(m_byUniqueId.size() + count);
+    }
+
+    template<typename T>
+    void IdIndex<T>::ensure(const std::vector<T>& items)
+    {
+        if (!m_valid || m_size != items.size() || m_data != items.data())
+            rebuild(items);
+    }
+
+    template<typename T>
+    template<typename Key>
+    size_t IdIndex<T>::find(const std::vector<T>& items, const Key& key, Key T::* field, std::unordered_map<Key, size_t>& map)
+    {
+        if (key.empty())
+            return npos;
+
+        ensure(items);
+
+        // Verify each hit so reordered or edited items trigger a rebuild
+        for (int attempt = 0; attempt < 2; ++attempt)
+        {
+            const auto it = map.find(key);
+            if (it == map.end())
+                return npos;
+
+            if (items[it->second].*field == key)
+                return it->second;
+
+            rebuild(items);
+        }
+
+        return npos;
+    }
+
+    template<typename T>
+    size_t IdIndex<T>::find_id(const std::vector<T>& items, const std::string& id)
+    {
+        return find(items, id, &T::id, m_byId);
+    }
+
+    template<typename T>
+    size_t IdIndex<T>::find_unique_id(const std::vector<T>& items, const UniqueId& uniqueId)
+    {
+        return find(items, uniqueId, &T::uniqueId, m_byUniqueId);
+    }
+
+    template<typename T>
+    size_t IdIndex<T>::insert(std::vector<T>& items, T&& item)
+    {
+        if (find_id(items, item.id) != npos || find_unique_id(items, item.uniqueId) != npos)
+            return npos;
+
+        return append(items, std::move(item));
+    }
+
+    template<typename T>
+    size_t IdIndex<T>::append(std::vector<T>& items, T&& item)
+    {
+        // The lookups left the index current, so only the new entries are added
+        ensure(items);
+        const size_t position = items.size();
+        items.push_back(std::move(item));
+
+        if (!items.back().id.empty())
+            m_byId.emplace(items.back().id, position);
+
+        if (!items.back().uniqueId.empty())
+            m_byUniqueId.emplace(items.back().uniqueId, position);
+
+        m_data = items.data();
+        m_size = items.size();
+        return position;
+    }
+
+    template<typename T>
+    void IdIndex<T>::erase(std::vector<T>& items, const size_t position)
+    {
+        ensure(items);
+
+        // With duplicate ids another item may own the key; start over instead
+        if (m_hasDuplicates)
+        {
+            if (position != items.size() - 1)
+                items[position] = std::move(items.back());
+
+            items.pop_back();
+            m_valid = false;
+            return;
+        }
+
+        m_byId.erase(items[position].id);
+        m_byUniqueId.erase(items[position].uniqueId);
+
+        const size_t last = items.size() - 1;
+        if (position != last)
+        {
+            items[position] = std::move(items[last]);
+            if (!items[position].id.empty())
+                m_byId[items[position].id] = position;
+
+            if (!items[position].uniqueId.empty())
+                m_byUniqueId[items[position].uniqueId] = position;
+        }
+
+        items.pop_back();
+        m_data = items.data();
+        m_size = items.size();
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
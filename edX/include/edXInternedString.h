@@ -0,0 +1,152 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXInternedString.h
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <atomic>
+#include <compare>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <edX/config/edXConfig.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    namespace detail
+    {
+        // Pool entry; counts the handles that refer to it
+        struct PooledString
+        {
+            explicit PooledString(std::string_view value) : text(value) {}
+
+            std::string text;
+            mutable std::atomic<size_t> references = 0;
+        };
+
+        inline const std::string& empty_pooled_text()
+        {
+            static const std::string empty;
+            return empty;
+        }
+    }
+
+    /**
+     * @brief Pointer-sized handle to a string in the shared intern pool
+     *
+     * Equal texts always share one pooled copy, so comparing handles is O(1)
+     * and copying one never allocates. Used for asset fields that repeat a
+     * few distinct values across many assets (library, layer and group).
+     *
+     * Converts implicitly to and from std::string so it can be assigned,
+     * compared and passed like one. The pool is process-wide and thread-safe,
+     * so handles may be copied freely between projects. Entries are reference
+     * counted: a string leaves the pool with the last handle to it, so closing
+     * a project gives its names back. Values with many distinct texts belong
+     * in plain strings rather than here.
+     */
+    class EDX_API InternedString
+    {
+    public:
+        InternedString() = default;
+        InternedString(std::string_view text);
+        InternedString(const std::string& text) : InternedString(std::string_view(text)) {}
+        InternedString(const char* text) : InternedString(std::string_view(text)) {}
+
+        InternedString(const InternedString& other) noexcept : m_entry(other.m_entry)
+        {
+            if (m_entry != nullptr)
+                m_entry->references.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        InternedString(InternedString&& other) noexcept : m_entry(std::exchange(other.m_entry, nullptr)) {}
+
+        ~InternedString()
+        {
+            if (m_entry != nullptr)
+                release(m_entry);
+        }
+
+        InternedString& operator=(const InternedString& other) noexcept
+        {
+            InternedString copy(other);
+            std::swap(m_entry, copy.m_entry);
+            return *this;
+        }
+
+        InternedString& operator=(InternedString&& other) noexcept
+        {
+            InternedString taken(std::move(other));
+            std::swap(m_entry, taken.m_entry);
+            return *this;
+        }
+
+        [[nodiscard]] const std::string& str() const { return m_entry != nullptr ? m_entry->text : detail::empty_pooled_text(); }
+        [[nodiscard]] std::string_view view() const { return str(); }
+        [[nodiscard]] const char* c_str() const { return str().c_str(); }
+        [[nodiscard]] bool empty() const { return m_entry == nullptr; }
+        [[nodiscard]] size_t size() const { return str().size(); }
+
+        operator const std::string&() const { return str(); }
+
+        // Handles compare by identity; ordering follows the text
+        friend bool operator==(const InternedString& a, const InternedString& b) { return a.m_entry == b.m_entry; }
+        friend bool operator==(const InternedString& a, const std::string& b) { return a.str() == b; }
+        friend bool operator==(const InternedString& a, std::string_view b) { return a.str() == b; }
+        friend bool operator==(const InternedString& a, const char* b) { return a.str() == b; }
+        friend std::strong_ordering operator<=>(const InternedString& a, const InternedString& b)
+        {
+            return a.m_entry == b.m_entry ? std::strong_ordering::equal : a.str() <=> b.str();
+        }
+
+        friend std::ostream& operator<<(std::ostream& stream, const InternedString& s) { return stream << s.str(); }
+
+        // Number of distinct strings in the pool
+        [[nodiscard]] static size_t pool_size();
+
+    private:
+        friend struct std::hash<InternedString>;
+
+        static void release(const detail::PooledString* entry) noexcept;
+
+        // Null for the empty string, which is never pooled
+        const detail::PooledString* m_entry = nullptr;
+    };
+
+    // nlohmann::json conversions (found by ADL)
+    inline void to_json(json& j, const InternedString& s) { j = s.str(); }
+    inline void from_json(const json& j, InternedString& s) { s = InternedString(j.get_ref<const std::string&>()); }
+
+} // namespace edx
+
+template<>
+struct std::hash<edx::InternedString>
+{
+    size_t operator()(const edx::InternedString& s) const noexcept { return std::hash<const void*>{}(s.m_entry); }
+};
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,101 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXLazyProject.h
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <vector>
+#include <edX/config/edXConfig.h>
+#include <edX/include/edXFileIO.h>
+#include <edX/include/edXProjectFile.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    /**
+     * @brief Project whose bulky sections are parsed on first access
+     *
+     * open() maps the file and makes a single skim pass over its top-level
+     * members. Project, Airport and Libraries are parsed straight away; for
+     * Assets, Layers and Settings only the byte range is recorded and the
+     * section is materialized the first time its accessor is called. The file
+     * stays mapped until every section has been loaded.
+     *
+     * Binary (.edxb) and compressed projects have no text to index, so open()
+     * reads them completely. Not thread-safe: accessors may parse and modify state.
+     */
+    class EDX_API LazyEdxProject
+    {
+    public:
+        // Location of a section's value within the file
+        struct SectionSpan
+        {
+            size_t offset = 0;
+            size_t length = 0;
+        };
+
+        LazyEdxProject() = default;
+
+        // Map the file, parse the metadata sections and index the rest
+        bool open(const std::filesystem::path& filePath);
+
+        [[nodiscard]] const ProjectInfo& project() const { return m_project.project; }
+        [[nodiscard]] const AirportInfo& airport() const { return m_project.airport; }
+        [[nodiscard]] const std::vector<LibraryReference>& libraries() const { return m_project.libraries; }
+
+        // Parsed on first access; throw if the section turns out to be malformed
+        std::vector<SceneAsset>& assets();
+        std::vector<SceneLayer>& layers();
+        json& settings();
+
+        [[nodiscard]] bool assets_loaded() const { return !m_assetsSpan; }
+        [[nodiscard]] bool layers_loaded() const { return !m_layersSpan; }
+        [[nodiscard]] bool settings_loaded() const { return !m_settingsSpan; }
+
+        // Byte ranges recorded by open() for sections that are still pending
+        [[nodiscard]] std::optional<SectionSpan> assets_span() const { return m_assetsSpan; }
+        [[nodiscard]] std::optional<SectionSpan> layers_span() const { return m_layersSpan; }
+        [[nodiscard]] std::optional<SectionSpan> settings_span() const { return m_settingsSpan; }
+
+        // Load any pending sections and move the complete project out
+        EdxProject take_project();
+
+    private:
+        void load_section(const char* key, std::optional<SectionSpan>& span);
+        void release_file_if_done();
+
+        EdxProject m_project;
+        std::shared_ptr<const MappedFile> m_file;
+        std::optional<SectionSpan> m_assetsSpan;
+        std::optional<SectionSpan> m_layersSpan;
+        std::optional<SectionSpan> m_settingsSpan;
+        std::optional<SectionSpan> m_propertyTableSpan; // Read with the assets
+    };
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
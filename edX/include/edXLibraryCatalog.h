@@ -0,0 +1,138 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXLibraryCatalog.h
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <edX/config/edXConfig.h>
+#include <edX/include/edXFileIO.h>
+#include <edX/include/edXLibraryFile.h>
+#include <edX/include/edXUniqueId.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    /**
+     * @brief The browsing fields of one library object
+     */
+    struct EDX_API CatalogObject
+    {
+        std::string id;
+        UniqueId uniqueId;
+        std::string name;
+        std::string assetType;
+        std::string category;
+        std::vector<std::string> tags;
+
+        // JSON serialization support
+        void to_json(json& j) const;
+        void from_json(const json& j);
+    };
+
+    /**
+     * @brief Summary of one library file as recorded in a LibraryCatalog
+     *
+     * The size, modification time and content hash identify the file version
+     * the summary was taken from.
+     */
+    struct EDX_API CatalogEntry
+    {
+        std::filesystem::path path;
+        uint64_t fileSize = 0;
+        int64_t modified = 0; // std::filesystem::file_time_type ticks
+        uint64_t contentHash = 0;
+
+        Library library;
+        std::vector<CatalogObject> objects;
+
+        // Distinct values in sorted order with the number of objects holding each
+        std::vector<std::pair<std::string, size_t>> categories;
+        std::vector<std::pair<std::string, size_t>> assetTypes;
+
+        // Summarize a loaded library
+        static CatalogEntry summarize(const LibraryFile& library);
+
+        // JSON serialization support
+        void to_json(json& j) const;
+        void from_json(const json& j);
+    };
+
+    /**
+     * @brief On-disk cache of library summaries for fast startup
+     *
+     * refresh() checks each library file against its entry: an unchanged size
+     * and modification time reuses the entry without reading the file, a
+     * changed time with unchanged content only updates the time, and anything
+     * else parses the library again. The catalog is stored as CBOR.
+     *
+     * A file whose modification time is not older than the catalog file's own
+     * is racy: it may have been rewritten within the same timestamp after it
+     * was summarized, so it is hashed before its entry is trusted. Saving the
+     * catalog again settles such entries. A catalog that was never loaded or
+     * saved hashes every file.
+     */
+    class EDX_API LibraryCatalog
+    {
+    public:
+        struct RefreshResult
+        {
+            size_t unchanged = 0; // Served from the catalog without reading the file
+            size_t touched = 0;   // Read and hashed, but the content was the same
+            size_t parsed = 0;    // New or changed libraries that were loaded
+            size_t removed = 0;   // Entries whose file is gone
+            std::vector<std::filesystem::path> failed; // Unreadable or invalid libraries
+        };
+
+        // Replace the catalog with one saved by save(). Returns false, leaving
+        // the catalog empty, if the file is missing, corrupt or of another version.
+        bool load(const std::filesystem::path& catalogPath);
+        [[nodiscard]] bool save(const std::filesystem::path& catalogPath, Durability durability = Durability::Data) const;
+
+        // Bring the catalog in line with the library files under a directory
+        // (recursively) or with an explicit list; other entries are dropped
+        RefreshResult refresh(const std::filesystem::path& directory, std::string_view extension = ".edxlib");
+        RefreshResult refresh(std::vector<std::filesystem::path> files);
+
+        // Entries sorted by path
+        [[nodiscard]] const std::vector<CatalogEntry>& entries() const { return m_entries; }
+        [[nodiscard]] const CatalogEntry* find(const std::filesystem::path& path) const;
+
+        // True if the catalog changed since it was loaded or saved
+        [[nodiscard]] bool dirty() const { return m_dirty; }
+
+    private:
+        std::vector<CatalogEntry> m_entries;
+        mutable bool m_dirty = false;
+        mutable int64_t m_savedAt = INT64_MIN; // Catalog file time ticks, INT64_MIN if unknown
+    };
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
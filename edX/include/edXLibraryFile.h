@@ -25,12 +25,23 @@
 * -------------------------------------------------------
 */
 #pragma once
+#include <cstdint>
 #include <filesystem>
+#include <optional>
 #include <random>
+#include <span>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <edX/config/edXConfig.h>
+#include <edX/include/edXFileIO.h>
+#include <edX/include/edXIdIndex.h>
+#include <edX/include/edXObjectFacets.h>
+#include <edX/include/edXObjectSearch.h>
+#include <edX/include/edXPropertySchema.h>
+#include <edX/include/edXSharedJson.h>
+#include <edX/include/edXUniqueId.h>
 
 /// ----------------------------------------------------------------------------
 
@@ -46,17 +57,7 @@ namespace edx
      */
     inline std::string generateRandomHexValue()
     {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution dis(0, 15);
-
-        std::stringstream ss;
-        for (int i = 0; i < 8; ++i) // Generate 8 hexadecimal digits
-        {
-            ss << std::hex << dis(gen);
-        }
-
-        return ss.str();
+        return UniqueId::generate().str();
     }
 
     /**
@@ -91,13 +92,13 @@ namespace edx
     struct EDX_API LibraryObject
     {
         std::string id;
-        std::string uniqueId;
+        UniqueId uniqueId;
         std::string assetType;
         std::string name;
         std::string description;
 
-        // Asset properties stored as JSON for flexibility
-        json properties;
+        // Asset properties stored as JSON for flexibility; identical blobs are shared after a load
+        SharedJson properties;
 
         // Object classification
         std::string category;
@@ -113,6 +114,34 @@ namespace edx
         void from_json(const json& j);
     };
 
+    /**
+     * @brief Outcome of LibraryFile::add_objects
+     *
+     * Lists each object that was turned away, by its position in the input,
+     * instead of printing a warning per object.
+     */
+    struct EDX_API ObjectIngestReport
+    {
+        enum class Reason : uint8_t
+        {
+            DuplicateId,      // id already used by the library or earlier in the input
+            DuplicateUniqueId // id is free but the unique id is taken
+        };
+
+        struct Rejected
+        {
+            size_t index = 0;
+            std::string id;
+            UniqueId uniqueId;
+            Reason reason = Reason::DuplicateId;
+        };
+
+        size_t added = 0;
+        std::vector<Rejected> rejected;
+
+        [[nodiscard]] bool all_added() const { return rejected.empty(); }
+    };
+
     /**
      * @brief Complete library file structure
      *
@@ -128,24 +157,110 @@ namespace edx
         void to_json(json& j) const;
         void from_json(const json& j);
 
+        // Parse an in-memory document (e.g. a MappedFile view) and load it
+        void from_json_buffer(std::string_view text);
+
+        // Load the contents of a library file, compressed or not. Throws on bad input.
+        void from_file_data(std::string_view data);
+
+        // Direct serialization without an intermediate json tree; matches to_json() + dump(4)
+        void write_json(OutputSink& sink, const SaveOptions& options = {}) const;
+
         // File operations
-        [[nodiscard]] bool save_to_file(const std::filesystem::path &filePath) const;
+        [[nodiscard]] bool save_to_file(const std::filesystem::path &filePath, const SaveOptions& options = {}) const;
         bool load_from_file(const std::filesystem::path& filePath);
 
         // Validation
         [[nodiscard]] bool validate() const;
         [[nodiscard]] std::vector<std::string> get_validation_errors() const;
 
-        // Object management
+        // Object management in O(1) through hash indexes on id and uniqueId.
+        // add_object skips objects whose id or unique id is already in use.
+        // Lookups may rebuild the indexes, so they must not run concurrently.
         void add_object(const LibraryObject& obj);
-        bool remove_object(const std::string& id);
+        void add_object(LibraryObject&& obj);
         LibraryObject* find_object(const std::string& id);
         [[nodiscard]] const LibraryObject* find_object(const std::string& id) const;
+        LibraryObject* find_object_by_unique_id(const UniqueId& uniqueId);
+        [[nodiscard]] const LibraryObject* find_object_by_unique_id(const UniqueId& uniqueId) const;
+
+        // Appends many objects at once with the same duplicate rules as add_object,
+        // reserving storage up front. Pass the vector as an rvalue to avoid copies.
+        ObjectIngestReport add_objects(std::vector<LibraryObject> incoming);
+
+        // Removes the object by moving the last object into its place (object order changes)
+        bool remove_object(const std::string& id);
+
+        // Removes every object whose id is listed and keeps the rest in order,
+        // in one pass over the objects; returns the number removed
+        size_t remove_objects(const std::vector<std::string>& ids);
+
+        // Required after changing the ids, name, description, category, asset
+        // type or tags of objects in place
+        void invalidate_object_indexes() const
+        {
+            m_objectIndex.invalidate();
+            m_facetIndex.invalidate();
+            m_searchIndex.invalidate();
+        }
+
+        // Facet queries through inverted indexes on category, asset type and
+        // tag, kept up to date like the id indexes. Positions index objects.
+        [[nodiscard]] std::vector<size_t> query_objects(const ObjectQuery& query) const;
+        [[nodiscard]] std::span<const size_t> objects_with(ObjectFacet facet, std::string_view value) const;
+        [[nodiscard]] std::vector<std::pair<std::string, size_t>> facet_counts(ObjectFacet facet) const;
+        [[nodiscard]] std::vector<std::pair<std::string, size_t>> facet_counts(ObjectFacet facet, const ObjectQuery& query) const;
+
+        // Ranked search over names, tags and descriptions through a trigram
+        // index; every word of the query must occur (ASCII case is ignored)
+        [[nodiscard]] std::vector<SearchHit> search_objects(std::string_view query, size_t limit = 50) const;
+
+        // The search index in serialized form. Saving with SaveOptions::searchIndex
+        // writes it next to the library file, and loading picks it up from
+        // there while it still matches the objects.
+        void write_search_index(OutputSink& sink) const;
+        bool read_search_index(std::string_view data);
+        [[nodiscard]] static std::filesystem::path search_index_path(const std::filesystem::path& filePath);
+
+        // Makes objects with equal properties share one tree; returns the number
+        // of distinct blobs. Loading does this already.
+        size_t share_properties();
+
+        // Typed columns of the schema keys, one row per object in order
+        [[nodiscard]] PropertyColumns property_columns(PropertySchema schema) const;
 
         // Statistics
         [[nodiscard]] size_t get_object_count() const { return objects.size(); }
         [[nodiscard]] std::vector<std::string> get_categories() const;
         [[nodiscard]] std::vector<std::string> get_asset_types() const;
+
+    private:
+        mutable IdIndex<LibraryObject> m_objectIndex;
+        mutable FacetIndex m_facetIndex;
+        mutable SearchIndex m_searchIndex;
+    };
+
+    struct EDX_API LibrarySearchHit
+    {
+        size_t library = 0;  // Index into the searched libraries
+        size_t position = 0; // Index into that library's objects
+        uint32_t score = 0;
+    };
+
+    // LibraryFile::search_objects over several libraries, best matches first
+    [[nodiscard]] EDX_API std::vector<LibrarySearchHit> search_libraries(std::span<const LibraryFile* const> libraries, std::string_view query, size_t limit = 50);
+
+    /**
+     * @brief Library metadata read without loading the library
+     *
+     * Filled from the Library section only; the object list is never read.
+     */
+    struct EDX_API LibraryFileHeader
+    {
+        Library library;
+
+        // Returns nullopt if the file is not a readable edX library
+        [[nodiscard]] static std::optional<LibraryFileHeader> probe(const std::filesystem::path& filePath);
     };
 
 } // namespace edx
@@ -30,6 +30,7 @@
 #include <string>
 #include <vector>
 #include <edX/config/edXConfig.h>
+#include <edX/include/edXLazyProject.h>
 #include <edX/include/edXLibraryFile.h>
 #include <edX/include/edXProjectFile.h>
 
@@ -92,6 +93,33 @@ namespace edx
          */
         bool save_project(const EdxProject& project, const std::string& filePath, const ProgressCallback &progressCallback = nullptr );
 
+        /**
+         * @brief Open a project whose assets, layers and settings load on first access
+         *
+         * @param filePath Path to the .edX or .edxb file
+         * @return Unique pointer to the opened project, nullptr on failure
+         */
+        std::unique_ptr<LazyEdxProject> open_project_lazy(const std::string& filePath);
+
+        /**
+         * @brief Load a project from a binary .edxb file
+         *
+         * @param filePath Path to the .edxb file
+         * @param progressCallback Optional progress callback
+         * @return Unique pointer to the loaded project, nullptr on failure
+         */
+        std::unique_ptr<EdxProject> load_binary_project(const std::string& filePath, const ProgressCallback &progressCallback = nullptr);
+
+        /**
+         * @brief Save a project to a binary .edxb file
+         *
+         * @param project Project to save
+         * @param filePath Path where to save the .edxb file
+         * @param progressCallback Optional progress callback
+         * @return True if successful, false otherwise
+         */
+        bool save_binary_project(const EdxProject& project, const std::string& filePath, const ProgressCallback &progressCallback = nullptr);
+
         //////////////////////////////////////////////////////
         // Library file operations
         //////////////////////////////////////////////////////
@@ -166,6 +194,8 @@ namespace edx
         /**
          * @brief Check if a file is a valid edX project file
          *
+         * Only the file header is probed; assets and layers are not loaded.
+         *
          * @param filePath Path to check
          * @return True if valid, false otherwise
          */
@@ -174,11 +204,29 @@ namespace edx
         /**
          * @brief Check if a file is a valid edX library file
          *
+         * Only the file header is probed; library objects are not loaded.
+         *
          * @param filePath Path to check
          * @return True if valid, false otherwise
          */
         bool is_valid_library_file(const std::string& filePath);
 
+        /**
+         * @brief Read project and airport metadata without loading the project
+         *
+         * @param filePath Path to the .edX or .edxb file
+         * @return Header metadata, std::nullopt if the file is not a valid project
+         */
+        [[nodiscard]] std::optional<ProjectFileHeader> read_project_header(const std::string& filePath) const;
+
+        /**
+         * @brief Read library metadata without loading the library
+         *
+         * @param filePath Path to the library file
+         * @return Header metadata, std::nullopt if the file is not a valid library
+         */
+        [[nodiscard]] std::optional<LibraryFileHeader> read_library_header(const std::string& filePath) const;
+
         //////////////////////////////////////////////////////
         // Error and progress handling
         //////////////////////////////////////////////////////
@@ -0,0 +1,124 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXObjectFacets.h
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <edX/config/edXConfig.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    struct LibraryObject;
+
+    // Object fields the facet index covers
+    enum class ObjectFacet : uint8_t
+    {
+        Category,
+        AssetType,
+        Tag
+    };
+
+    /**
+     * @brief Objects matching every given facet value
+     *
+     * Empty fields match anything; an object must carry all listed tags.
+     */
+    struct EDX_API ObjectQuery
+    {
+        std::string category{};
+        std::string assetType{};
+        std::vector<std::string> tags{};
+    };
+
+    /**
+     * @brief Inverted indexes from category, asset type and tag to object positions
+     *
+     * Position lists are kept in ascending order, so queries intersect them
+     * without sorting. LibraryFile keeps the index current as objects are
+     * added or removed one at a time, and rebuilds it lazily after bulk
+     * removals or a load. Direct edits to the objects
+     * vector are caught when they change its size or storage; editing a field
+     * in place needs invalidate(). Empty values are not indexed.
+     */
+    class EDX_API FacetIndex
+    {
+    public:
+        FacetIndex() = default;
+        FacetIndex(const FacetIndex&) {}
+        FacetIndex& operator=(const FacetIndex&) { invalidate(); return *this; }
+
+        void invalidate() { m_valid = false; }
+        void rebuild(const std::vector<LibraryObject>& objects);
+
+        // Index objects appended since the index was last current
+        void extend(const std::vector<LibraryObject>& objects);
+
+        // Call before the object at position is overwritten by the last object
+        // and the last object is popped
+        void remove(const std::vector<LibraryObject>& objects, size_t position);
+
+        // Positions of the objects holding the value; valid until the next change
+        [[nodiscard]] std::span<const size_t> positions(const std::vector<LibraryObject>& objects, ObjectFacet facet, std::string_view value);
+
+        // Distinct values in sorted order, and how many objects hold each
+        [[nodiscard]] std::vector<std::string> values(const std::vector<LibraryObject>& objects, ObjectFacet facet);
+        [[nodiscard]] std::vector<std::pair<std::string, size_t>> counts(const std::vector<LibraryObject>& objects, ObjectFacet facet);
+
+        // Positions matching the query in ascending order
+        [[nodiscard]] std::vector<size_t> query(const std::vector<LibraryObject>& objects, const ObjectQuery& query);
+
+        // Value counts among the objects matching the query; values with no match are left out
+        [[nodiscard]] std::vector<std::pair<std::string, size_t>> counts(const std::vector<LibraryObject>& objects, ObjectFacet facet, const ObjectQuery& query);
+
+    private:
+        using Postings = std::map<std::string, std::vector<size_t>, std::less<>>;
+
+        void ensure(const std::vector<LibraryObject>& objects);
+        void add(const LibraryObject& object, size_t position);
+
+        // Calls visit(postings, value) once per distinct indexed value of the
+        // object; stops and returns false as soon as visit does
+        template<typename Visitor>
+        bool visit_values(const LibraryObject& object, Visitor visit);
+        [[nodiscard]] const Postings& postings(const ObjectFacet facet) const { return m_postings[static_cast<size_t>(facet)]; }
+
+        std::array<Postings, 3> m_postings;
+        const LibraryObject* m_data = nullptr;
+        size_t m_size = 0;
+        bool m_valid = false;
+    };
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
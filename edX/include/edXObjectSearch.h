@@ -0,0 +1,98 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXObjectSearch.h
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <edX/config/edXConfig.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    class OutputSink;
+    struct LibraryObject;
+
+    struct EDX_API SearchHit
+    {
+        size_t position = 0; // Index into the objects
+        uint32_t score = 0;  // Higher is better
+    };
+
+    /**
+     * @brief Trigram index over object names, tags and descriptions
+     *
+     * Every run of three bytes within a field (ASCII letters folded to lower
+     * case) maps to the ascending positions of the objects containing it,
+     * along with the fields it occurs in. A query word of three or more bytes
+     * narrows the candidates to objects holding all its trigrams in one field;
+     * shorter words match anywhere. Candidates are checked for the words
+     * themselves and ranked, name matches first, in order of the best score
+     * they could reach, so the search stops once the top hits are settled.
+     *
+     * Maintained like FacetIndex: extended as objects are appended, updated in
+     * place for swap-and-pop removals, rebuilt lazily after anything else.
+     */
+    class EDX_API SearchIndex
+    {
+    public:
+        SearchIndex() = default;
+        SearchIndex(const SearchIndex&) {}
+        SearchIndex& operator=(const SearchIndex&) { invalidate(); return *this; }
+
+        void invalidate() { m_valid = false; }
+        void rebuild(const std::vector<LibraryObject>& objects);
+
+        // Index objects appended since the index was last current
+        void extend(const std::vector<LibraryObject>& objects);
+
+        // Call before the object at position is overwritten by the last object
+        // and the last object is popped
+        void remove(const std::vector<LibraryObject>& objects, size_t position);
+
+        // Best matches first, at most limit of them
+        [[nodiscard]] std::vector<SearchHit> search(const std::vector<LibraryObject>& objects, std::string_view query, size_t limit);
+
+        // Serialized index, tied to the text of the objects it was built from
+        void write(OutputSink& sink, const std::vector<LibraryObject>& objects);
+
+        // Adopt a serialized index; false (leaving the index untouched) if the
+        // data is malformed or was written for other objects
+        bool read(const std::vector<LibraryObject>& objects, std::string_view data);
+
+    private:
+        void ensure(const std::vector<LibraryObject>& objects);
+
+        std::unordered_map<uint32_t, std::vector<uint32_t>> m_postings;
+        const LibraryObject* m_data = nullptr;
+        size_t m_size = 0;
+        bool m_valid = false;
+    };
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
@@ -26,10 +26,19 @@
 */
 #pragma once
 #include <filesystem>
+#include <iosfwd>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 #include <edX/config/edXConfig.h>
+#include <edX/include/edXFileIO.h>
+#include <edX/include/edXIdIndex.h>
+#include <edX/include/edXInternedString.h>
+#include <edX/include/edXSharedJson.h>
+#include <edX/include/edXUniqueId.h>
 
 /// ----------------------------------------------------------------------------
 
@@ -126,7 +135,7 @@ namespace edx
     struct EDX_API SceneAsset
     {
         std::string id;
-        std::string uniqueId;
+        UniqueId uniqueId;
 
         // Geographic positioning (WGS84)
         double latitude = 0.0;
@@ -134,18 +143,18 @@ namespace edx
         double altitude = 0.0;
         double heading = 0.0;
 
-        // Asset organization
-        std::string associatedLibrary;
-        std::string layerId;
-        std::string groupId;
+        // Asset organization; few distinct values, so interned
+        InternedString associatedLibrary;
+        InternedString layerId;
+        InternedString groupId;
 
         // Visual properties
         bool locked = false;
         bool hidden = false;
         bool selected = false;
 
-        // Additional properties stored as JSON
-        json otherProperties;
+        // Additional properties stored as JSON; identical blobs are shared after a load
+        SharedJson otherProperties;
 
         // JSON serialization support
         void to_json(json& j) const;
@@ -179,6 +188,9 @@ namespace edx
         void from_json(const json& j);
     };
 
+    // Asset lookup indexes of EdxProject
+    using AssetIndex = IdIndex<SceneAsset>;
+
     /**
      * @brief Complete edX project file structure
      *
@@ -200,13 +212,85 @@ namespace edx
         void to_json(json& j) const;
         void from_json(const json& j);
 
-        // File operations
-        [[nodiscard]] bool save_to_file(const std::filesystem::path& filePath) const;
-        bool load_from_file(const std::filesystem::path& filePath);
+        // Streaming deserialization: fills the project straight from SAX events
+        // without building a document DOM. Throws like from_json on bad input.
+        void from_json_stream(std::istream& stream);
+
+        // Same as from_json_stream but parses an in-memory document, e.g. a
+        // MappedFile view. Much faster than going through a stream buffer.
+        // With LoadOptions::threadCount != 1 the Assets and Layers arrays are
+        // split at element boundaries and parsed on several threads.
+        void from_json_buffer(std::string_view text, const LoadOptions& options = {});
+
+        // Direct serialization: streams each section into the sink without an
+        // intermediate json tree. Output matches to_json() + dump(4) byte for byte.
+        void write_json(OutputSink& sink, const SaveOptions& options = {}) const;
+        void write_json(std::ostream& stream, const SaveOptions& options = {}) const;
+
+        // File operations; loading accepts JSON, compressed JSON and binary files
+        [[nodiscard]] bool save_to_file(const std::filesystem::path& filePath, const SaveOptions& options = {}) const;
+        bool load_from_file(const std::filesystem::path& filePath, const LoadOptions& options = {});
+
+        // Binary (.edxb) format: packed asset columns, interned strings and
+        // CBOR property blobs. Round-trips losslessly with the JSON format.
+        void write_binary(OutputSink& sink, const SaveOptions& options = {}) const;
+        void from_binary_buffer(std::string_view data);
+        [[nodiscard]] bool save_to_binary_file(const std::filesystem::path& filePath, const SaveOptions& options = {}) const;
+        bool load_from_binary_file(const std::filesystem::path& filePath);
+
+        // True if the bytes start with the .edxb signature
+        [[nodiscard]] static bool is_binary_data(std::string_view leadingBytes);
 
         // Validation
         [[nodiscard]] bool validate() const;
         [[nodiscard]] std::vector<std::string> get_validation_errors() const;
+
+        // Asset lookup in O(1) through hash indexes on id and uniqueId. Lookups
+        // may rebuild the indexes, so they must not run concurrently with each
+        // other unless the indexes are known to be current.
+        SceneAsset* find_asset(const std::string& id);
+        [[nodiscard]] const SceneAsset* find_asset(const std::string& id) const;
+        SceneAsset* find_asset_by_unique_id(const UniqueId& uniqueId);
+        [[nodiscard]] const SceneAsset* find_asset_by_unique_id(const UniqueId& uniqueId) const;
+
+        // Appends the asset; nullptr if its id or unique id is already in use
+        SceneAsset* insert_asset(SceneAsset asset);
+
+        // Removes the asset by moving the last asset into its place (asset order changes)
+        bool erase_asset(const std::string& id);
+        bool erase_asset_by_unique_id(const UniqueId& uniqueId);
+
+        // Required after changing the id or uniqueId of assets in place; the
+        // indexes are rebuilt on the next lookup
+        void invalidate_asset_indexes() const { m_assetIndex.invalidate(); }
+
+        // Makes assets with equal otherProperties share one tree and returns the
+        // number of distinct blobs. Loading does this already; call it after
+        // building up a project in code.
+        size_t share_properties();
+
+        // Reorders assets along a Hilbert curve over their positions (see
+        // SaveOptions::spatialOrder). Layers keep working as they list asset ids.
+        void sort_assets_spatially();
+
+    private:
+        mutable AssetIndex m_assetIndex;
+    };
+
+    /**
+     * @brief Project metadata read without loading the project
+     *
+     * Filled from the Project and Airport sections only; assets and layers
+     * are skipped over, never deserialized. Meant for listing many projects.
+     */
+    struct EDX_API ProjectFileHeader
+    {
+        ProjectInfo project;
+        AirportInfo airport;
+        bool binary = false; // .edxb rather than JSON
+
+        // Returns nullopt if the file is not a readable edX project (JSON or .edxb)
+        [[nodiscard]] static std::optional<ProjectFileHeader> probe(const std::filesystem::path& filePath);
     };
 
 }
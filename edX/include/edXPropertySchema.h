@@ -0,0 +1,226 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXPropertySchema.h
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <edX/config/edXConfig.h>
+#include <edX/include/edXSharedJson.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    enum class PropertyType : uint8_t
+    {
+        Bool,
+        Integer,
+        Number, // Any json number, stored as double
+        String  // Dictionary-encoded per column, as most property strings repeat
+    };
+
+    /**
+     * @brief Known property keys and the type each is expected to hold
+     *
+     * Fields are numbered in the order they are added; the number is the
+     * column index used by PropertyColumns.
+     */
+    class EDX_API PropertySchema
+    {
+    public:
+        // Field index of the key; adding a key again returns its index, but
+        // throws if the type differs
+        size_t add(std::string key, PropertyType type);
+
+        [[nodiscard]] std::optional<size_t> find(std::string_view key) const;
+
+        [[nodiscard]] size_t size() const { return m_fields.size(); }
+        [[nodiscard]] bool empty() const { return m_fields.empty(); }
+        [[nodiscard]] const std::string& key(size_t field) const { return m_fields[field].key; }
+        [[nodiscard]] PropertyType type(size_t field) const { return m_fields[field].type; }
+
+    private:
+        struct Field
+        {
+            std::string key;
+            PropertyType type;
+        };
+
+        std::vector<Field> m_fields;
+    };
+
+    /**
+     * @brief Typed columns for the schema keys of a sequence of property blobs
+     *
+     * Row i holds the schema fields of the i-th blob. A field the blob lacks,
+     * holds with another type, or holds as an unsigned integer past int64_t,
+     * is marked absent and keeps a zero value; it and every key outside the
+     * schema stay readable from the json itself.
+     *
+     * On their own the columns are a decoded copy and do not follow later
+     * edits to the blobs; LibraryFile::property_columns builds one that way.
+     * AssetStore::promote_properties instead moves the values out of the
+     * blobs, making the columns the only copy and the typed setters the way
+     * to change them.
+     *
+     * Rows whose blobs share one tree (see PropertyPool) are decoded once.
+     */
+    class EDX_API PropertyColumns
+    {
+    public:
+        PropertyColumns() = default;
+        explicit PropertyColumns(PropertySchema schema);
+        PropertyColumns(PropertySchema schema, std::span<const SharedJson> blobs);
+
+        // Columns over the blobs a projection picks out of a range of items
+        template<typename Range, typename Projection>
+        [[nodiscard]] static PropertyColumns build(PropertySchema schema, const Range& range, Projection projection);
+
+        void append(const json& blob);
+        void reserve(size_t count);
+        void clear();
+
+        [[nodiscard]] const PropertySchema& schema() const { return m_schema; }
+        [[nodiscard]] size_t size() const { return m_rows; }
+
+        // 1 where the row holds the field with the schema type
+        [[nodiscard]] std::span<const uint8_t> present(size_t field) const { return m_columns.at(field).present; }
+
+        // Values of one field; throws std::logic_error if the field has another type
+        [[nodiscard]] std::span<const uint8_t> bools(size_t field) const;
+        [[nodiscard]] std::span<const int64_t> integers(size_t field) const;
+        [[nodiscard]] std::span<const double> numbers(size_t field) const;
+
+        // String fields hold a code per row into a dictionary owned by the
+        // column; absent rows read as the empty string
+        [[nodiscard]] std::span<const uint32_t> string_codes(size_t field) const;
+        [[nodiscard]] std::string_view string(size_t field, size_t row) const;
+
+        // Rows where the field is present and predicate(value) holds. T is
+        // bool, int64_t, double or std::string_view to match the field type;
+        // string predicates run once per distinct value.
+        template<typename T, typename Predicate>
+        [[nodiscard]] std::vector<size_t> filter(size_t field, Predicate predicate) const;
+
+        // Typed writes make the field present in the row; erase marks it absent.
+        // Setters throw std::logic_error if the field has another type.
+        void set_bool(size_t field, size_t row, bool value);
+        void set_integer(size_t field, size_t row, int64_t value);
+        void set_number(size_t field, size_t row, double value);
+        void set_string(size_t field, size_t row, std::string_view value);
+        void erase(size_t field, size_t row);
+
+        // True if the row holds any field
+        [[nodiscard]] bool has_values(size_t row) const;
+
+        // Remove the row's present fields from a json object, or store them
+        // back. Values a column cannot reproduce exactly (an integer in a
+        // Number field) are left in place, and write_row keeps keys the
+        // object already holds.
+        void strip_row(size_t row, json& blob) const;
+        void write_row(size_t row, json& blob) const;
+
+    private:
+        struct Column
+        {
+            std::vector<uint8_t> present;
+            std::vector<uint8_t> bools;
+            std::vector<int64_t> integers;
+            std::vector<double> numbers;
+            std::vector<uint32_t> codes;
+            std::vector<std::string> dictionary;
+            std::unordered_multimap<size_t, uint32_t> codesByHash;
+        };
+
+        const Column& column(size_t field, PropertyType type) const;
+        // Column for a typed write to the row; marks the field present
+        Column& writable(size_t field, PropertyType type, size_t row);
+        static uint32_t encode(Column& column, std::string_view text);
+        void repeat_row(size_t row);
+
+        PropertySchema m_schema;
+        std::vector<Column> m_columns;
+        size_t m_rows = 0;
+    };
+
+    template<typename Range, typename Projection>
+    PropertyColumns PropertyColumns::build(PropertySchema schema, const Range& range, Projection projection)
+    {
+        // The handles keep every tree alive, so shared ones are recognised by address
+        std::vector<SharedJson> blobs;
+        for (const auto& item : range)
+            blobs.push_back(projection(item));
+
+        return PropertyColumns(std::move(schema), blobs);
+    }
+
+    template<typename T, typename Predicate>
+    std::vector<size_t> PropertyColumns::filter(const size_t field, Predicate predicate) const
+    {
+        std::span<const uint8_t> present = this->present(field);
+        std::vector<size_t> rows;
+        const auto scan = [&](const auto values)
+        {
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                if (present[i] && predicate(static_cast<T>(values[i])))
+                    rows.push_back(i);
+            }
+        };
+
+        if constexpr (std::is_same_v<T, bool>)
+            scan(bools(field));
+        else if constexpr (std::is_same_v<T, int64_t>)
+            scan(integers(field));
+        else if constexpr (std::is_same_v<T, double>)
+            scan(numbers(field));
+        else
+        {
+            static_assert(std::is_same_v<T, std::string_view>, "filter type must be bool, int64_t, double or std::string_view");
+            const Column& strings = column(field, PropertyType::String);
+            std::vector<uint8_t> matches(strings.dictionary.size());
+            for (size_t code = 0; code < matches.size(); ++code)
+                matches[code] = predicate(std::string_view(strings.dictionary[code])) ? 1 : 0;
+
+            for (size_t i = 0; i < strings.codes.size(); ++i)
+            {
+                if (present[i] && matches[strings.codes[i]])
+                    rows.push_back(i);
+            }
+        }
+
+        return rows;
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
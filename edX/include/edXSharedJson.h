@@ -0,0 +1,170 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXSharedJson.h
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <edX/config/edXConfig.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    /**
+     * @brief Copy-on-write handle to an immutable json value
+     *
+     * Copies share one tree. Reads go through get() (or the implicit
+     * conversion); the first write through edit() or the non-const
+     * operator[] detaches a private copy if the tree is shared, so sharing
+     * is never observable. Used for property blobs, where most assets carry
+     * one of a handful of identical objects.
+     *
+     * A default-constructed value is null and allocates nothing.
+     */
+    class EDX_API SharedJson
+    {
+    public:
+        SharedJson();
+        SharedJson(json value);
+
+        // Anything json can be built from, so maps, strings and initializer lists assign as before
+        template<typename T>
+            requires (!std::is_same_v<std::remove_cvref_t<T>, json> && !std::is_same_v<std::remove_cvref_t<T>, SharedJson> &&
+                      std::is_constructible_v<json, T>)
+        SharedJson(T&& value) : SharedJson(json(std::forward<T>(value))) {}
+
+        [[nodiscard]] const json& get() const { return *m_value; }
+        operator const json&() const { return *m_value; }
+        const json* operator->() const { return m_value.get(); }
+
+        // Mutable access; copies the tree first if anything else shares it
+        json& edit();
+
+        template<typename Key>
+        json& operator[](Key&& key) { return edit()[std::forward<Key>(key)]; }
+
+        template<typename Key>
+        const json& operator[](Key&& key) const { return get()[std::forward<Key>(key)]; }
+
+        [[nodiscard]] bool empty() const { return m_value->empty(); }
+        [[nodiscard]] bool is_null() const { return m_value->is_null(); }
+
+        // True if both handles point at the same tree
+        [[nodiscard]] bool shares_with(const SharedJson& other) const { return m_value == other.m_value; }
+
+        friend bool operator==(const SharedJson& a, const SharedJson& b) { return a.m_value == b.m_value || *a.m_value == *b.m_value; }
+        friend bool operator==(const SharedJson& a, const json& b) { return *a.m_value == b; }
+
+        friend std::ostream& operator<<(std::ostream& stream, const SharedJson& value) { return stream << *value.m_value; }
+
+    private:
+        friend class PropertyPool;
+
+        explicit SharedJson(std::shared_ptr<json> value) : m_value(std::move(value)) {}
+
+        std::shared_ptr<json> m_value;
+    };
+
+    // nlohmann::json conversions (found by ADL); templates so they never apply
+    // through SharedJson's converting constructor
+    template<std::same_as<SharedJson> T>
+    void to_json(json& j, const T& value) { j = value.get(); }
+
+    template<std::same_as<SharedJson> T>
+    void from_json(const json& j, T& value) { value = SharedJson(j); }
+
+    /**
+     * @brief Content-hashed table that makes equal property blobs share one tree
+     *
+     * intern() returns a handle to the first equal value the pool has seen, so
+     * a project holds each distinct blob once. Null values are never pooled.
+     * The pool keeps every tree it has seen alive, so use one per load or
+     * share() pass and drop it afterwards. Not thread-safe.
+     */
+    class EDX_API PropertyPool
+    {
+    public:
+        SharedJson intern(json value);
+        SharedJson intern(const SharedJson& value);
+
+        // Share equal blobs across a whole range of values in place
+        template<typename Range, typename Projection>
+        void share(Range& range, Projection projection);
+
+        [[nodiscard]] size_t size() const { return m_size; }
+        void clear();
+
+    private:
+        const std::shared_ptr<json>* find(const json& value, size_t hash) const;
+
+        std::unordered_map<size_t, std::vector<std::shared_ptr<json>>> m_blobs;
+
+        // Trees already resolved by address, so sharing a range hashes each
+        // distinct tree once; the source is held so its address is not reused
+        std::unordered_map<const json*, std::pair<SharedJson, SharedJson>> m_byAddress;
+        size_t m_size = 0;
+    };
+
+    /**
+     * @brief Numbers the distinct property blobs of a document for writers
+     *
+     * Equal blobs get the same index whether or not they share a tree. The
+     * entries point into the values passed to add(), which must outlive the table.
+     */
+    class EDX_API PropertyTable
+    {
+    public:
+        static constexpr uint32_t NONE = UINT32_MAX;
+
+        // Index of the value's blob, appended on first sight; NONE for null values
+        uint32_t add(const SharedJson& value);
+
+        [[nodiscard]] const std::vector<const json*>& entries() const { return m_entries; }
+
+    private:
+        std::unordered_map<const json*, uint32_t> m_byAddress;
+        std::unordered_map<size_t, std::vector<uint32_t>> m_byHash;
+        std::vector<const json*> m_entries;
+    };
+
+    template<typename Range, typename Projection>
+    void PropertyPool::share(Range& range, Projection projection)
+    {
+        for (auto& item : range)
+        {
+            SharedJson& value = projection(item);
+            value = intern(value);
+        }
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
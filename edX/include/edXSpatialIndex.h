@@ -0,0 +1,125 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXSpatialIndex.h
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <edX/config/edXConfig.h>
+#include <edX/include/edXAssetStore.h>
+#include <edX/include/edXProjectFile.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    // Mean Earth radius used for great-circle distances
+    inline constexpr double EARTH_RADIUS_METERS = 6371008.8;
+
+    // Great-circle (haversine) distance between two WGS84 positions in metres
+    [[nodiscard]] EDX_API double great_circle_distance(double latitude1, double longitude1, double latitude2, double longitude2);
+
+    // Position along a Hilbert curve laid over the whole globe, with cells of
+    // about a centimetre; positions close together mostly get close keys
+    [[nodiscard]] EDX_API uint64_t hilbert_key(double latitude, double longitude);
+
+    // Asset positions in the order they are visited along the Hilbert curve;
+    // assets sharing a cell keep their relative order
+    [[nodiscard]] EDX_API std::vector<size_t> hilbert_order(const std::vector<SceneAsset>& assets);
+
+    /**
+     * @brief Grid index over asset latitude/longitude
+     *
+     * Entries are bucketed into square lat/lon cells held in a hash map, so
+     * only occupied cells cost memory and the grid covers the whole globe.
+     * build() sizes the cells from the data (about 32 assets per cell);
+     * queries visit only the cells overlapping the search area.
+     *
+     * Entries are identified by a key chosen by the caller, normally the
+     * asset's position in EdxProject::assets. When an asset is erased by
+     * moving the last one into its place, erase() its key and rekey() the
+     * moved asset to the freed position.
+     */
+    class EDX_API SpatialIndex
+    {
+    public:
+        SpatialIndex() : SpatialIndex(0.01) {}
+        explicit SpatialIndex(double cellSizeDegrees);
+
+        // Bulk build with each asset's position as its key
+        void build(const std::vector<SceneAsset>& assets);
+        void build(const AssetStore& store);
+        void clear();
+
+        void insert(size_t key, double latitude, double longitude);
+        bool erase(size_t key);
+        bool move(size_t key, double latitude, double longitude);
+        bool rekey(size_t from, size_t to);
+
+        [[nodiscard]] bool contains(size_t key) const;
+        [[nodiscard]] size_t size() const { return m_size; }
+        [[nodiscard]] double cell_size() const { return m_cellSize; }
+
+        // Keys inside the rectangle; minLongitude > maxLongitude crosses the antimeridian
+        [[nodiscard]] std::vector<size_t> query_rect(const GeoBounds& bounds) const;
+
+        // Keys within a great-circle distance of a point
+        [[nodiscard]] std::vector<size_t> query_radius(double latitude, double longitude, double radiusMeters) const;
+
+        // The k keys closest to a point, nearest first
+        [[nodiscard]] std::vector<size_t> nearest(double latitude, double longitude, size_t k) const;
+
+    private:
+        struct Entry
+        {
+            size_t key;
+            double latitude;
+            double longitude;
+        };
+
+        static constexpr uint64_t NO_CELL = ~uint64_t(0);
+
+        void reset_grid(double cellSize);
+        void bulk_build(size_t count, const double* latitudes, const double* longitudes);
+        [[nodiscard]] int64_t row_of(double latitude) const;
+        [[nodiscard]] int64_t column_of(double longitude) const;
+        [[nodiscard]] uint64_t cell_of(double latitude, double longitude) const;
+        Entry* find_entry(size_t key);
+
+        template<typename Visitor>
+        void visit_cells(const GeoBounds& bounds, Visitor&& visitor) const;
+
+        double m_cellSize = 0.01;
+        int64_t m_rows = 0;
+        int64_t m_columns = 0;
+        size_t m_size = 0;
+
+        std::unordered_map<uint64_t, std::vector<Entry>> m_cells;
+        std::vector<uint64_t> m_cellOfKey; // Indexed by key; NO_CELL when absent
+    };
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
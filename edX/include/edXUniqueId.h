@@ -0,0 +1,147 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXUniqueId.h
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <edX/config/edXConfig.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    /**
+     * @brief 64-bit unique identifier that keeps the hex text form of the file format
+     *
+     * Lowercase hex ids of up to 15 digits, which includes every id from
+     * generateRandomHexValue(), are packed into the integer together with
+     * their digit count, so leading zeros survive a round trip; copying,
+     * comparing and hashing them never touch a string. Any other text
+     * (UUIDs, uppercase or longer ids) is kept in a reference-counted block
+     * that copies share and the last copy frees, so nothing outlives the ids
+     * that use it. Those ids compare by text and hash by a cached text hash.
+     *
+     * Converts implicitly from std::string; str() prints the original text.
+     * Comparing with a string parses it in place and never allocates.
+     */
+    class EDX_API UniqueId
+    {
+    public:
+        UniqueId() = default;
+        UniqueId(std::string_view text);
+        UniqueId(const std::string& text) : UniqueId(std::string_view(text)) {}
+        UniqueId(const char* text) : UniqueId(std::string_view(text)) {}
+
+        UniqueId(const UniqueId& other) noexcept : m_bits(other.m_bits) { if (is_text()) retain(); }
+        UniqueId(UniqueId&& other) noexcept : m_bits(std::exchange(other.m_bits, 0)) {}
+        ~UniqueId() { if (is_text()) release(); }
+
+        UniqueId& operator=(const UniqueId& other) noexcept
+        {
+            UniqueId copy(other);
+            std::swap(m_bits, copy.m_bits);
+            return *this;
+        }
+
+        UniqueId& operator=(UniqueId&& other) noexcept
+        {
+            UniqueId taken(std::move(other));
+            std::swap(m_bits, taken.m_bits);
+            return *this;
+        }
+
+        // Random 8-digit id, the same shape as generateRandomHexValue()
+        [[nodiscard]] static UniqueId generate();
+
+        // Id for a 32-bit value printed as 8 hex digits
+        [[nodiscard]] static UniqueId from_hex32(uint32_t value);
+
+        [[nodiscard]] bool empty() const { return m_bits == 0; }
+
+        // True for ids packed as hex digits rather than held as text
+        [[nodiscard]] bool is_hex() const { return (m_bits >> LENGTH_SHIFT) != 0; }
+
+        // Text form; ids of 15 characters or fewer fit the small string buffer
+        [[nodiscard]] std::string str() const;
+
+        // Equal ids hash equally, whichever way they are stored
+        [[nodiscard]] size_t hash() const noexcept
+        {
+            if (is_text())
+                return text_hash();
+
+            // Random ids are already well mixed; this spreads small counters
+            uint64_t x = m_bits;
+            x ^= x >> 33;
+            x *= 0xff51afd7ed558ccdULL;
+            x ^= x >> 33;
+            return static_cast<size_t>(x);
+        }
+
+        friend bool operator==(const UniqueId& a, const UniqueId& b)
+        {
+            return a.m_bits == b.m_bits || (a.is_text() && b.is_text() && same_text(a, b));
+        }
+
+        friend bool operator==(const UniqueId& a, std::string_view b) { return a.equals(b); }
+        friend bool operator==(const UniqueId& a, const std::string& b) { return a.equals(b); }
+        friend bool operator==(const UniqueId& a, const char* b) { return a.equals(b); }
+
+        friend std::ostream& operator<<(std::ostream& stream, const UniqueId& id) { return stream << id.str(); }
+
+    private:
+        // Top four bits hold the hex digit count; zero means the low bits point
+        // to a shared text block (or are zero too, for the empty id)
+        static constexpr int LENGTH_SHIFT = 60;
+        static constexpr uint64_t VALUE_MASK = (uint64_t{1} << LENGTH_SHIFT) - 1;
+
+        [[nodiscard]] bool is_text() const { return m_bits != 0 && !is_hex(); }
+
+        void retain() const noexcept;
+        void release() noexcept;
+        [[nodiscard]] size_t text_hash() const noexcept;
+        [[nodiscard]] bool equals(std::string_view text) const;
+        [[nodiscard]] static bool same_text(const UniqueId& a, const UniqueId& b);
+
+        uint64_t m_bits = 0;
+    };
+
+    // nlohmann::json conversions (found by ADL)
+    inline void to_json(json& j, const UniqueId& id) { j = id.str(); }
+    inline void from_json(const json& j, UniqueId& id) { id = UniqueId(j.get_ref<const std::string&>()); }
+
+} // namespace edx
+
+template<>
+struct std::hash<edx::UniqueId>
+{
+    size_t operator()(const edx::UniqueId& id) const noexcept { return id.hash(); }
+};
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,667 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXAssetKernels.cpp
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <edX/include/edXAssetStore.h>
+#include <edX/include/edXSpatialIndex.h>
+
+// SSE2 is part of the x86-64 baseline; other targets use the scalar loops,
+// which compilers vectorize for the host on their own
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define EDX_ASSET_KERNELS_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    namespace
+    {
+        // Map an offset in degrees into [-half, half) so one conditional wrap suffices afterwards
+        double reduce_degrees(const double degrees, const double period)
+        {
+            const double reduced = std::fmod(degrees, period);
+            if (reduced >= period / 2.0)
+                return reduced - period;
+            if (reduced < -period / 2.0)
+                return reduced + period;
+            return reduced;
+        }
+
+        void min_max(const std::span<const double> values, double& minValue, double& maxValue)
+        {
+            size_t i = 0;
+            double lo = minValue, hi = maxValue;
+
+#if defined(EDX_ASSET_KERNELS_SSE2)
+            __m128d lo0 = _mm_set1_pd(lo), lo1 = lo0;
+            __m128d hi0 = _mm_set1_pd(hi), hi1 = hi0;
+
+            // Two accumulators per bound hide the latency of min/max
+            for (; i + 4 <= values.size(); i += 4)
+            {
+                const __m128d a = _mm_loadu_pd(values.data() + i);
+                const __m128d b = _mm_loadu_pd(values.data() + i + 2);
+                lo0 = _mm_min_pd(lo0, a);
+                lo1 = _mm_min_pd(lo1, b);
+                hi0 = _mm_max_pd(hi0, a);
+                hi1 = _mm_max_pd(hi1, b);
+            }
+
+            alignas(16) double lanes[2];
+            _mm_store_pd(lanes, _mm_min_pd(lo0, lo1));
+            lo = std::min(lanes[0], lanes[1]);
+            _mm_store_pd(lanes, _mm_max_pd(hi0, hi1));
+            hi = std::max(lanes[0], lanes[1]);
+#endif
+
+            for (; i < values.size(); ++i)
+            {
+                lo = std::min(lo, values[i]);
+                hi = std::max(hi, values[i]);
+            }
+
+            minValue = lo;
+            maxValue = hi;
+        }
+
+        constexpr double DEG_TO_RAD = std::numbers::pi / 180.0;
+        constexpr double RAD_TO_DEG = 180.0 / std::numbers::pi;
+
+        /**
+         * Every group transform is an affine map of degree offsets: with
+         * dLat/dLon measured from the input origin,
+         *
+         *     lat = outLat + a * dLat + b * dLon
+         *     lon = outLon + c * dLat + d * dLon
+         *
+         * which is exact on a tangent plane whose east axis is scaled by the
+         * cosine of the origin latitude.
+         */
+        struct AffineMap
+        {
+            double inLatitude = 0.0, inLongitude = 0.0;
+            double outLatitude = 0.0, outLongitude = 0.0;
+            double a = 1.0, b = 0.0, c = 0.0, d = 1.0;
+            double heading = 0.0; // In [0, 360)
+            double altitude = 0.0;
+        };
+
+        double wrap_longitude(double lon)
+        {
+            if (lon >= 180.0)
+                lon -= 360.0;
+            else if (lon < -180.0)
+                lon += 360.0;
+            return lon;
+        }
+
+        double normalize_heading_delta(const double degrees)
+        {
+            double delta = std::fmod(degrees, 360.0);
+            if (delta < 0.0)
+                delta += 360.0;
+            return delta;
+        }
+
+        void map_one(const AffineMap& map, double& lat, double& lon, double& heading, double& altitude)
+        {
+            const double dLat = lat - map.inLatitude;
+            const double dLon = wrap_longitude(lon - map.inLongitude);
+            lat = std::clamp(map.outLatitude + map.a * dLat + map.b * dLon, -90.0, 90.0);
+            lon = wrap_longitude(map.outLongitude + map.c * dLat + map.d * dLon);
+
+            heading += map.heading;
+            if (heading >= 360.0)
+                heading -= 360.0;
+
+            altitude += map.altitude;
+        }
+
+#if defined(EDX_ASSET_KERNELS_SSE2)
+        struct AffineLanes
+        {
+            explicit AffineLanes(const AffineMap& map)
+                : inLat(_mm_set1_pd(map.inLatitude)), inLon(_mm_set1_pd(map.inLongitude)),
+                  outLat(_mm_set1_pd(map.outLatitude)), outLon(_mm_set1_pd(map.outLongitude)),
+                  a(_mm_set1_pd(map.a)), b(_mm_set1_pd(map.b)), c(_mm_set1_pd(map.c)), d(_mm_set1_pd(map.d)),
+                  heading(_mm_set1_pd(map.heading)), altitude(_mm_set1_pd(map.altitude)) {}
+
+            static __m128d wrap(__m128d lon)
+            {
+                const __m128d turn = _mm_set1_pd(360.0);
+                lon = _mm_sub_pd(lon, _mm_and_pd(_mm_cmpge_pd(lon, _mm_set1_pd(180.0)), turn));
+                return _mm_add_pd(lon, _mm_and_pd(_mm_cmplt_pd(lon, _mm_set1_pd(-180.0)), turn));
+            }
+
+            void apply(__m128d& lat, __m128d& lon, __m128d& hdg, __m128d& alt) const
+            {
+                const __m128d dLat = _mm_sub_pd(lat, inLat);
+                const __m128d dLon = wrap(_mm_sub_pd(lon, inLon));
+                lat = _mm_add_pd(outLat, _mm_add_pd(_mm_mul_pd(a, dLat), _mm_mul_pd(b, dLon)));
+                lat = _mm_min_pd(_mm_max_pd(lat, _mm_set1_pd(-90.0)), _mm_set1_pd(90.0));
+                lon = wrap(_mm_add_pd(outLon, _mm_add_pd(_mm_mul_pd(c, dLat), _mm_mul_pd(d, dLon))));
+
+                const __m128d turn = _mm_set1_pd(360.0);
+                hdg = _mm_add_pd(hdg, heading);
+                hdg = _mm_sub_pd(hdg, _mm_and_pd(_mm_cmpge_pd(hdg, turn), turn));
+
+                alt = _mm_add_pd(alt, altitude);
+            }
+
+            __m128d inLat, inLon, outLat, outLon, a, b, c, d, heading, altitude;
+        };
+#endif
+
+        // Apply to the selected assets, or to all of them when indices is null;
+        // callers with a selection return early when it is empty
+        void apply_affine(AssetStore& store, const AffineMap& map, const size_t* indices, const size_t count)
+        {
+            double* latitudes = store.latitudes().data();
+            double* longitudes = store.longitudes().data();
+            double* headings = store.headings().data();
+            double* altitudes = store.altitudes().data();
+            size_t i = 0;
+
+#if defined(EDX_ASSET_KERNELS_SSE2)
+            const AffineLanes lanes(map);
+            if (indices == nullptr)
+            {
+                for (; i + 2 <= count; i += 2)
+                {
+                    __m128d lat = _mm_loadu_pd(latitudes + i);
+                    __m128d lon = _mm_loadu_pd(longitudes + i);
+                    __m128d hdg = _mm_loadu_pd(headings + i);
+                    __m128d alt = _mm_loadu_pd(altitudes + i);
+                    lanes.apply(lat, lon, hdg, alt);
+                    _mm_storeu_pd(latitudes + i, lat);
+                    _mm_storeu_pd(longitudes + i, lon);
+                    _mm_storeu_pd(headings + i, hdg);
+                    _mm_storeu_pd(altitudes + i, alt);
+                }
+            }
+            else
+            {
+                // Selections are scattered, so pairs are gathered into lanes and scattered back
+                for (; i + 2 <= count; i += 2)
+                {
+                    const size_t i0 = indices[i], i1 = indices[i + 1];
+                    __m128d lat = _mm_set_pd(latitudes[i1], latitudes[i0]);
+                    __m128d lon = _mm_set_pd(longitudes[i1], longitudes[i0]);
+                    __m128d hdg = _mm_set_pd(headings[i1], headings[i0]);
+                    __m128d alt = _mm_set_pd(altitudes[i1], altitudes[i0]);
+                    lanes.apply(lat, lon, hdg, alt);
+                    _mm_storel_pd(latitudes + i0, lat);
+                    _mm_storeh_pd(latitudes + i1, lat);
+                    _mm_storel_pd(longitudes + i0, lon);
+                    _mm_storeh_pd(longitudes + i1, lon);
+                    _mm_storel_pd(headings + i0, hdg);
+                    _mm_storeh_pd(headings + i1, hdg);
+                    _mm_storel_pd(altitudes + i0, alt);
+                    _mm_storeh_pd(altitudes + i1, alt);
+                }
+            }
+#endif
+
+            for (; i < count; ++i)
+            {
+                const size_t k = indices != nullptr ? indices[i] : i;
+                map_one(map, latitudes[k], longitudes[k], headings[k], altitudes[k]);
+            }
+
+            if (indices == nullptr)
+                store.invalidate_enu();
+            else
+                store.invalidate_enu(std::span(indices, count));
+        }
+
+        // A repeated index would be transformed once or twice depending on
+        // where it falls in the SIMD gather, so selections must be strictly ascending
+        void check_selection(const AssetStore& store, const std::span<const size_t> selection)
+        {
+            for (size_t i = 0; i < selection.size(); ++i)
+            {
+                if (selection[i] >= store.size())
+                    throw std::out_of_range("Asset selection index " + std::to_string(selection[i]) + " is out of range");
+
+                if (i != 0 && selection[i] <= selection[i - 1])
+                    throw std::invalid_argument("Asset selection must be strictly ascending; index " + std::to_string(selection[i]) + " follows " +
+                                                std::to_string(selection[i - 1]));
+            }
+        }
+    }
+
+    //////////////////////////////////////////////////////
+    // Local frame
+    //////////////////////////////////////////////////////
+
+    LocalFrame::LocalFrame(const double originLatitude, const double originLongitude, const double originAltitude)
+        : m_latitude(originLatitude), m_longitude(originLongitude), m_altitude(originAltitude),
+          m_metresPerDegreeLatitude(EARTH_RADIUS_METERS * DEG_TO_RAD),
+          m_metresPerDegreeLongitude(EARTH_RADIUS_METERS * DEG_TO_RAD * std::cos(originLatitude * DEG_TO_RAD)) {}
+
+    void LocalFrame::to_enu(const double lat, const double lon, const double alt, double& east, double& north, double& up) const
+    {
+        east = wrap_longitude(lon - m_longitude) * m_metresPerDegreeLongitude;
+        north = (lat - m_latitude) * m_metresPerDegreeLatitude;
+        up = alt - m_altitude;
+    }
+
+    void LocalFrame::from_enu(const double east, const double north, const double up, double& lat, double& lon, double& alt) const
+    {
+        lat = m_latitude + north / m_metresPerDegreeLatitude;
+        lon = wrap_longitude(m_longitude + east / m_metresPerDegreeLongitude);
+        alt = m_altitude + up;
+    }
+
+    void AssetStore::update_enu()
+    {
+        if (!m_frame)
+            return;
+
+        const LocalFrame& frame = *m_frame;
+        const size_t count = size();
+        if (!m_enuStale && m_east.size() <= count)
+        {
+            // Incremental: rows appended since the last refresh are in the dirty list too
+            m_east.resize(count);
+            m_north.resize(count);
+            m_up.resize(count);
+            for (const size_t i : m_enuDirty)
+            {
+                if (i < count)
+                    frame.to_enu(m_latitudes[i], m_longitudes[i], m_altitudes[i], m_east[i], m_north[i], m_up[i]);
+            }
+
+            m_enuDirty.clear();
+            return;
+        }
+
+        m_east.resize(count);
+        m_north.resize(count);
+        m_up.resize(count);
+        size_t i = 0;
+
+#if defined(EDX_ASSET_KERNELS_SSE2)
+        const __m128d originLat = _mm_set1_pd(frame.latitude());
+        const __m128d originLon = _mm_set1_pd(frame.longitude());
+        const __m128d originAlt = _mm_set1_pd(frame.altitude());
+        const __m128d perLat = _mm_set1_pd(frame.metres_per_degree_latitude());
+        const __m128d perLon = _mm_set1_pd(frame.metres_per_degree_longitude());
+
+        for (; i + 2 <= count; i += 2)
+        {
+            const __m128d dLon = AffineLanes::wrap(_mm_sub_pd(_mm_loadu_pd(m_longitudes.data() + i), originLon));
+            _mm_storeu_pd(m_east.data() + i, _mm_mul_pd(dLon, perLon));
+            _mm_storeu_pd(m_north.data() + i, _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(m_latitudes.data() + i), originLat), perLat));
+            _mm_storeu_pd(m_up.data() + i, _mm_sub_pd(_mm_loadu_pd(m_altitudes.data() + i), originAlt));
+        }
+#endif
+
+        for (; i < count; ++i)
+            frame.to_enu(m_latitudes[i], m_longitudes[i], m_altitudes[i], m_east[i], m_north[i], m_up[i]);
+
+        m_enuDirty.clear();
+        m_enuStale = false;
+    }
+
+    bool AssetStore::enu_current() const
+    {
+        return !m_frame || (!m_enuStale && m_enuDirty.empty() && m_east.size() == size());
+    }
+
+    void AssetStore::require_current_enu() const
+    {
+        if (!enu_current())
+            throw std::logic_error("Local coordinates are out of date; call update_enu() first");
+    }
+
+    GeoBounds compute_bounds(const AssetStore& store)
+    {
+        GeoBounds bounds;
+        if (store.empty())
+            return bounds;
+
+        min_max(store.latitudes(), bounds.minLatitude, bounds.maxLatitude);
+        min_max(store.longitudes(), bounds.minLongitude, bounds.maxLongitude);
+        min_max(store.altitudes(), bounds.minAltitude, bounds.maxAltitude);
+        return bounds;
+    }
+
+    std::vector<size_t> filter_in_bounds(const AssetStore& store, const GeoBounds& bounds)
+    {
+        std::vector<size_t> result;
+        if (bounds.is_empty())
+            return result;
+
+        const double* latitudes = store.latitudes().data();
+        const double* longitudes = store.longitudes().data();
+        const size_t count = store.size();
+        const bool wraps = bounds.minLongitude > bounds.maxLongitude;
+        size_t i = 0;
+
+#if defined(EDX_ASSET_KERNELS_SSE2)
+        const __m128d minLat = _mm_set1_pd(bounds.minLatitude);
+        const __m128d maxLat = _mm_set1_pd(bounds.maxLatitude);
+        const __m128d minLon = _mm_set1_pd(bounds.minLongitude);
+        const __m128d maxLon = _mm_set1_pd(bounds.maxLongitude);
+
+        for (; i + 2 <= count; i += 2)
+        {
+            const __m128d lat = _mm_loadu_pd(latitudes + i);
+            const __m128d lon = _mm_loadu_pd(longitudes + i);
+
+            const __m128d inLat = _mm_and_pd(_mm_cmpge_pd(lat, minLat), _mm_cmple_pd(lat, maxLat));
+            const __m128d aboveMin = _mm_cmpge_pd(lon, minLon);
+            const __m128d belowMax = _mm_cmple_pd(lon, maxLon);
+            const __m128d inLon = wraps ? _mm_or_pd(aboveMin, belowMax) : _mm_and_pd(aboveMin, belowMax);
+
+            // Most blocks are rejected outright; only hits branch into the append
+            if (const int mask = _mm_movemask_pd(_mm_and_pd(inLat, inLon)))
+            {
+                if (mask & 1)
+                    result.push_back(i);
+                if (mask & 2)
+                    result.push_back(i + 1);
+            }
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            if (bounds.contains(latitudes[i], longitudes[i]))
+                result.push_back(i);
+        }
+
+        return result;
+    }
+
+    void translate_positions(AssetStore& store, const double latitudeDelta, const double longitudeDelta, const double altitudeDelta)
+    {
+        const double lonDelta = reduce_degrees(longitudeDelta, 360.0);
+        double* latitudes = store.latitudes().data();
+        double* longitudes = store.longitudes().data();
+        double* altitudes = store.altitudes().data();
+        const size_t count = store.size();
+        size_t i = 0;
+
+#if defined(EDX_ASSET_KERNELS_SSE2)
+        const __m128d dLat = _mm_set1_pd(latitudeDelta);
+        const __m128d dLon = _mm_set1_pd(lonDelta);
+        const __m128d dAlt = _mm_set1_pd(altitudeDelta);
+        const __m128d minLat = _mm_set1_pd(-90.0);
+        const __m128d maxLat = _mm_set1_pd(90.0);
+        const __m128d lonLow = _mm_set1_pd(-180.0);
+        const __m128d lonHigh = _mm_set1_pd(180.0);
+        const __m128d turn = _mm_set1_pd(360.0);
+
+        for (; i + 2 <= count; i += 2)
+        {
+            const __m128d lat = _mm_add_pd(_mm_loadu_pd(latitudes + i), dLat);
+            _mm_storeu_pd(latitudes + i, _mm_min_pd(_mm_max_pd(lat, minLat), maxLat));
+
+            // Branch-free wrap: subtract or add a full turn where the sum left the range
+            __m128d lon = _mm_add_pd(_mm_loadu_pd(longitudes + i), dLon);
+            lon = _mm_sub_pd(lon, _mm_and_pd(_mm_cmpge_pd(lon, lonHigh), turn));
+            lon = _mm_add_pd(lon, _mm_and_pd(_mm_cmplt_pd(lon, lonLow), turn));
+            _mm_storeu_pd(longitudes + i, lon);
+
+            _mm_storeu_pd(altitudes + i, _mm_add_pd(_mm_loadu_pd(altitudes + i), dAlt));
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            latitudes[i] = std::clamp(latitudes[i] + latitudeDelta, -90.0, 90.0);
+
+            double lon = longitudes[i] + lonDelta;
+            if (lon >= 180.0)
+                lon -= 360.0;
+            else if (lon < -180.0)
+                lon += 360.0;
+            longitudes[i] = lon;
+
+            altitudes[i] += altitudeDelta;
+        }
+
+        store.invalidate_enu();
+    }
+
+    void rotate_headings(AssetStore& store, const double degrees)
+    {
+        // In [0, 360) so a single subtraction brings every sum back into range
+        double delta = std::fmod(degrees, 360.0);
+        if (delta < 0.0)
+            delta += 360.0;
+
+        double* headings = store.headings().data();
+        const size_t count = store.size();
+        size_t i = 0;
+
+#if defined(EDX_ASSET_KERNELS_SSE2)
+        const __m128d d = _mm_set1_pd(delta);
+        const __m128d turn = _mm_set1_pd(360.0);
+
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128d heading = _mm_add_pd(_mm_loadu_pd(headings + i), d);
+            heading = _mm_sub_pd(heading, _mm_and_pd(_mm_cmpge_pd(heading, turn), turn));
+            _mm_storeu_pd(headings + i, heading);
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            double heading = headings[i] + delta;
+            if (heading >= 360.0)
+                heading -= 360.0;
+            headings[i] = heading;
+        }
+    }
+
+    void scale_positions(AssetStore& store, const double originLatitude, const double originLongitude, const double factor)
+    {
+        double* latitudes = store.latitudes().data();
+        double* longitudes = store.longitudes().data();
+        const size_t count = store.size();
+        size_t i = 0;
+
+#if defined(EDX_ASSET_KERNELS_SSE2)
+        const __m128d originLat = _mm_set1_pd(originLatitude);
+        const __m128d originLon = _mm_set1_pd(originLongitude);
+        const __m128d f = _mm_set1_pd(factor);
+        const __m128d minLat = _mm_set1_pd(-90.0);
+        const __m128d maxLat = _mm_set1_pd(90.0);
+        const __m128d lonLow = _mm_set1_pd(-180.0);
+        const __m128d lonHigh = _mm_set1_pd(180.0);
+        const __m128d turn = _mm_set1_pd(360.0);
+        const auto wrap = [&](__m128d lon)
+        {
+            lon = _mm_sub_pd(lon, _mm_and_pd(_mm_cmpge_pd(lon, lonHigh), turn));
+            return _mm_add_pd(lon, _mm_and_pd(_mm_cmplt_pd(lon, lonLow), turn));
+        };
+
+        for (; i + 2 <= count; i += 2)
+        {
+            const __m128d lat = _mm_add_pd(originLat, _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(latitudes + i), originLat), f));
+            _mm_storeu_pd(latitudes + i, _mm_min_pd(_mm_max_pd(lat, minLat), maxLat));
+
+            // Offsets go the short way round; one turn of wrap covers factors up to 2
+            const __m128d dLon = wrap(_mm_sub_pd(_mm_loadu_pd(longitudes + i), originLon));
+            const __m128d lon = wrap(_mm_add_pd(originLon, _mm_mul_pd(dLon, f)));
+            _mm_storeu_pd(longitudes + i, lon);
+            if (_mm_movemask_pd(_mm_or_pd(_mm_cmplt_pd(lon, lonLow), _mm_cmpge_pd(lon, lonHigh))) != 0)
+            {
+                longitudes[i] = reduce_degrees(longitudes[i], 360.0);
+                longitudes[i + 1] = reduce_degrees(longitudes[i + 1], 360.0);
+            }
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            latitudes[i] = std::clamp(originLatitude + (latitudes[i] - originLatitude) * factor, -90.0, 90.0);
+
+            const double dLon = wrap_longitude(longitudes[i] - originLongitude);
+            longitudes[i] = reduce_degrees(originLongitude + dLon * factor, 360.0);
+        }
+
+        store.invalidate_enu();
+    }
+
+    //////////////////////////////////////////////////////
+    // Group transforms
+    //////////////////////////////////////////////////////
+
+    std::vector<size_t> select_layer(const AssetStore& store, const InternedString& layerId)
+    {
+        std::vector<size_t> selection;
+        const auto& layers = store.layer_ids();
+        for (size_t i = 0; i < layers.size(); ++i)
+        {
+            if (layers[i] == layerId)
+                selection.push_back(i);
+        }
+
+        return selection;
+    }
+
+    std::vector<size_t> select_group(const AssetStore& store, const InternedString& groupId)
+    {
+        std::vector<size_t> selection;
+        const auto& groups = store.group_ids();
+        for (size_t i = 0; i < groups.size(); ++i)
+        {
+            if (groups[i] == groupId)
+                selection.push_back(i);
+        }
+
+        return selection;
+    }
+
+    std::vector<size_t> select_ids(const AssetStore& store, const std::span<const std::string> ids)
+    {
+        const std::unordered_set<std::string_view> wanted(ids.begin(), ids.end());
+        std::vector<size_t> selection;
+        const auto& storeIds = store.ids();
+        for (size_t i = 0; i < storeIds.size(); ++i)
+        {
+            if (wanted.contains(storeIds[i]))
+                selection.push_back(i);
+        }
+
+        return selection;
+    }
+
+    std::vector<size_t> select_flagged(const AssetStore& store, const uint8_t flags)
+    {
+        std::vector<size_t> selection;
+        const auto storeFlags = store.flags();
+        for (size_t i = 0; i < storeFlags.size(); ++i)
+        {
+            if ((storeFlags[i] & flags) != 0)
+                selection.push_back(i);
+        }
+
+        return selection;
+    }
+
+    void translate_metres(AssetStore& store, const std::span<const size_t> selection, const double east, const double north, const double up)
+    {
+        check_selection(store, selection);
+        if (selection.empty())
+            return;
+
+        // One east scale for the whole group keeps it rigid; taken at its mean latitude
+        double latitudeSum = 0.0;
+        for (const size_t index : selection)
+            latitudeSum += store.latitudes()[index];
+        const double centre = latitudeSum / static_cast<double>(selection.size());
+
+        AffineMap map;
+        map.outLatitude = north / EARTH_RADIUS_METERS * RAD_TO_DEG;
+        map.outLongitude = east / (EARTH_RADIUS_METERS * std::cos(centre * DEG_TO_RAD)) * RAD_TO_DEG;
+        map.altitude = up;
+        apply_affine(store, map, selection.data(), selection.size());
+    }
+
+    void rotate_about(AssetStore& store, const std::span<const size_t> selection, const double originLatitude, const double originLongitude, const double degrees)
+    {
+        check_selection(store, selection);
+        if (selection.empty())
+            return;
+
+        // Clockwise rotation of (east, north), with east = dLon * k
+        const double k = std::cos(originLatitude * DEG_TO_RAD);
+        const double s = std::sin(degrees * DEG_TO_RAD);
+        const double c = std::cos(degrees * DEG_TO_RAD);
+
+        AffineMap map;
+        map.inLatitude = map.outLatitude = originLatitude;
+        map.inLongitude = map.outLongitude = originLongitude;
+        map.a = c;
+        map.b = -s * k;
+        map.c = s / k;
+        map.d = c;
+        map.heading = normalize_heading_delta(degrees);
+        apply_affine(store, map, selection.data(), selection.size());
+    }
+
+    void scale_about(AssetStore& store, const std::span<const size_t> selection, const double originLatitude, const double originLongitude, const double factor)
+    {
+        check_selection(store, selection);
+        if (selection.empty())
+            return;
+
+        AffineMap map;
+        map.inLatitude = map.outLatitude = originLatitude;
+        map.inLongitude = map.outLongitude = originLongitude;
+        map.a = factor;
+        map.d = factor;
+        apply_affine(store, map, selection.data(), selection.size());
+    }
+
+    void rebase_datum(AssetStore& store, const double oldLatitude, const double oldLongitude, const double newLatitude, const double newLongitude)
+    {
+        // Metres east are dLon * cos(latitude), so longitude offsets rescale between datums
+        AffineMap map;
+        map.inLatitude = oldLatitude;
+        map.inLongitude = oldLongitude;
+        map.outLatitude = newLatitude;
+        map.outLongitude = newLongitude;
+        map.d = std::cos(oldLatitude * DEG_TO_RAD) / std::cos(newLatitude * DEG_TO_RAD);
+        apply_affine(store, map, nullptr, store.size());
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,305 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXAssetStore.cpp
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <edX/include/edXAssetStore.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    AssetStore::AssetStore(const std::vector<SceneAsset>& assets)
+    {
+        reserve(assets.size());
+        for (const auto& asset : assets)
+            append(asset);
+    }
+
+    AssetStore::AssetStore(std::vector<SceneAsset>&& assets)
+    {
+        reserve(assets.size());
+        for (auto& asset : assets)
+            append(std::move(asset));
+
+        assets.clear();
+    }
+
+    template<typename Asset>
+    void AssetStore::append(Asset&& asset)
+    {
+        m_latitudes.push_back(asset.latitude);
+        m_longitudes.push_back(asset.longitude);
+        m_altitudes.push_back(asset.altitude);
+        m_headings.push_back(asset.heading);
+        m_flags.push_back(static_cast<uint8_t>((asset.locked ? Locked : 0) | (asset.hidden ? Hidden : 0) | (asset.selected ? Selected : 0)));
+
+        // Moves the strings and properties when given an rvalue
+        m_ids.push_back(std::forward<Asset>(asset).id);
+        m_uniqueIds.push_back(std::forward<Asset>(asset).uniqueId);
+        m_libraries.push_back(std::forward<Asset>(asset).associatedLibrary);
+        m_layerIds.push_back(std::forward<Asset>(asset).layerId);
+        m_groupIds.push_back(std::forward<Asset>(asset).groupId);
+        m_properties.push_back(std::forward<Asset>(asset).otherProperties);
+        if (!m_propertyColumns.schema().empty())
+        {
+            m_propertyColumns.append(m_properties.back());
+            if (m_propertyColumns.has_values(size() - 1))
+                m_propertyColumns.strip_row(size() - 1, m_properties.back().edit());
+        }
+
+        if (m_frame && !m_enuStale)
+            m_enuDirty.push_back(size() - 1);
+    }
+
+    void AssetStore::push_back(const SceneAsset& asset) { append(asset); }
+    void AssetStore::push_back(SceneAsset&& asset) { append(std::move(asset)); }
+
+    std::vector<SceneAsset> AssetStore::to_assets() const
+    {
+        std::vector<SharedJson> properties = all_full_properties();
+        std::vector<SceneAsset> assets(size());
+        for (size_t i = 0; i < assets.size(); ++i)
+        {
+            SceneAsset& asset = assets[i];
+            asset.id = m_ids[i];
+            asset.uniqueId = m_uniqueIds[i];
+            asset.latitude = m_latitudes[i];
+            asset.longitude = m_longitudes[i];
+            asset.altitude = m_altitudes[i];
+            asset.heading = m_headings[i];
+            asset.associatedLibrary = m_libraries[i];
+            asset.layerId = m_layerIds[i];
+            asset.groupId = m_groupIds[i];
+            asset.locked = (m_flags[i] & Locked) != 0;
+            asset.hidden = (m_flags[i] & Hidden) != 0;
+            asset.selected = (m_flags[i] & Selected) != 0;
+            asset.otherProperties = std::move(properties[i]);
+        }
+
+        return assets;
+    }
+
+    SharedJson AssetStore::full_properties(const size_t index) const
+    {
+        if (m_propertyColumns.schema().empty() || !m_propertyColumns.has_values(index))
+            return m_properties.at(index);
+
+        json blob = m_properties[index].get();
+        m_propertyColumns.write_row(index, blob);
+        return blob;
+    }
+
+    std::vector<SharedJson> AssetStore::all_full_properties() const
+    {
+        // Equal merged blobs share a tree again, as they did before promotion
+        PropertyPool pool;
+        std::vector<SharedJson> properties;
+        properties.reserve(size());
+        for (size_t i = 0; i < size(); ++i)
+        {
+            if (m_propertyColumns.schema().empty() || !m_propertyColumns.has_values(i))
+            {
+                properties.push_back(m_properties[i]);
+                continue;
+            }
+
+            json blob = m_properties[i].get();
+            m_propertyColumns.write_row(i, blob);
+            properties.push_back(pool.intern(std::move(blob)));
+        }
+
+        return properties;
+    }
+
+    void AssetStore::write_positions(std::vector<SceneAsset>& assets) const
+    {
+        const size_t count = std::min(assets.size(), size());
+        for (size_t i = 0; i < count; ++i)
+        {
+            assets[i].latitude = m_latitudes[i];
+            assets[i].longitude = m_longitudes[i];
+            assets[i].altitude = m_altitudes[i];
+            assets[i].heading = m_headings[i];
+        }
+    }
+
+    void AssetStore::reserve(const size_t count)
+    {
+        m_latitudes.reserve(count);
+        m_longitudes.reserve(count);
+        m_altitudes.reserve(count);
+        m_headings.reserve(count);
+        m_flags.reserve(count);
+        m_ids.reserve(count);
+        m_uniqueIds.reserve(count);
+        m_libraries.reserve(count);
+        m_layerIds.reserve(count);
+        m_groupIds.reserve(count);
+        m_properties.reserve(count);
+        m_propertyColumns.reserve(count);
+    }
+
+    void AssetStore::clear()
+    {
+        m_latitudes.clear();
+        m_longitudes.clear();
+        m_altitudes.clear();
+        m_headings.clear();
+        m_flags.clear();
+        m_ids.clear();
+        m_uniqueIds.clear();
+        m_libraries.clear();
+        m_layerIds.clear();
+        m_groupIds.clear();
+        m_properties.clear();
+        m_propertyColumns.clear();
+        m_east.clear();
+        m_north.clear();
+        m_up.clear();
+        m_enuDirty.clear();
+        m_enuStale = false;
+    }
+
+    void AssetStore::promote_properties(PropertySchema schema)
+    {
+        // Whole blobs, so the previous schema's values are not lost
+        const std::vector<SharedJson> blobs = all_full_properties();
+        PropertyColumns columns = schema.empty() ? PropertyColumns(std::move(schema)) : PropertyColumns(std::move(schema), blobs);
+
+        // Take the promoted values out once per distinct tree; the source
+        // handles in blobs keep every address valid for the pass
+        std::vector<SharedJson> stripped;
+        stripped.reserve(blobs.size());
+        std::unordered_map<const json*, SharedJson> strippedTrees;
+        for (size_t i = 0; i < blobs.size(); ++i)
+        {
+            if (columns.schema().empty() || !columns.has_values(i))
+            {
+                stripped.push_back(blobs[i]);
+                continue;
+            }
+
+            const auto [it, inserted] = strippedTrees.try_emplace(&blobs[i].get());
+            if (inserted)
+            {
+                json blob = blobs[i].get();
+                columns.strip_row(i, blob);
+                it->second = std::move(blob);
+            }
+
+            stripped.push_back(it->second);
+        }
+
+        m_properties = std::move(stripped);
+        m_propertyColumns = std::move(columns);
+    }
+
+    void AssetStore::set_property_bool(const size_t index, const size_t field, const bool value)
+    {
+        m_propertyColumns.set_bool(field, index, value);
+        drop_json_property(index, field);
+    }
+
+    void AssetStore::set_property_integer(const size_t index, const size_t field, const int64_t value)
+    {
+        m_propertyColumns.set_integer(field, index, value);
+        drop_json_property(index, field);
+    }
+
+    void AssetStore::set_property_number(const size_t index, const size_t field, const double value)
+    {
+        m_propertyColumns.set_number(field, index, value);
+        drop_json_property(index, field);
+    }
+
+    void AssetStore::set_property_string(const size_t index, const size_t field, const std::string_view value)
+    {
+        m_propertyColumns.set_string(field, index, value);
+        drop_json_property(index, field);
+    }
+
+    void AssetStore::erase_property(const size_t index, const size_t field)
+    {
+        m_propertyColumns.erase(field, index);
+        drop_json_property(index, field);
+    }
+
+    void AssetStore::drop_json_property(const size_t index, const size_t field)
+    {
+        // A value left in the blob (wrong type, or not exact as a column value) would shadow the column
+        const std::string& key = m_propertyColumns.schema().key(field);
+        const json& blob = m_properties[index].get();
+        if (blob.is_object() && blob.contains(key))
+            m_properties[index].edit().erase(key);
+    }
+
+    void AssetStore::set_local_frame(const LocalFrame& frame)
+    {
+        m_frame = frame;
+        invalidate_enu();
+    }
+
+    void AssetStore::clear_local_frame()
+    {
+        m_frame.reset();
+        m_east = {};
+        m_north = {};
+        m_up = {};
+        m_enuDirty = {};
+        m_enuStale = false;
+    }
+
+    void AssetStore::invalidate_enu(const std::span<const size_t> indices)
+    {
+        if (!m_frame || m_enuStale)
+            return;
+
+        // Past a point one batch pass is cheaper than chasing scattered indices
+        if (m_enuDirty.size() + indices.size() > size() / 2)
+        {
+            invalidate_enu();
+            return;
+        }
+
+        m_enuDirty.insert(m_enuDirty.end(), indices.begin(), indices.end());
+    }
+
+    bool GeoBounds::contains(const double latitude, const double longitude) const
+    {
+        if (latitude < minLatitude || latitude > maxLatitude)
+            return false;
+
+        // Rectangles across the antimeridian wrap around
+        if (minLongitude > maxLongitude)
+            return longitude >= minLongitude || longitude <= maxLongitude;
+
+        return longitude >= minLongitude && longitude <= maxLongitude;
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,502 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXBinaryFormat.cpp
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+#include <edX/include/edXProjectFile.h>
+#include <edX/include/edXSharedJson.h>
+#include <edX/include/edXSpatialIndex.h>
+#include <edX/src/edXBinaryFormat.h>
+
+/// ----------------------------------------------------------------------------
+
+/**
+ * .edxb layout (all integers little-endian)
+ *
+ *   header   "EDXB" u16 version u16 reserved
+ *   chunk*   u32 tag u64 size <size bytes>
+ *
+ * META  CBOR document holding the Project, Airport, Libraries, Layers and
+ *       Settings sections exactly as EdxProject::to_json writes them.
+ * STRS  u32 count, then count x (u32 length, bytes). Interned ids, library,
+ *       layer and group names referenced by index from ASET.
+ * PROP  u32 count, then count x (u32 length, CBOR bytes). Each distinct
+ *       other-properties object once, referenced by index from ASET.
+ * ASET  u64 count, then columns of count entries each:
+ *       f64 latitude, f64 longitude, f64 altitude, f64 heading,
+ *       u32 id, u32 associated-library, u32 layer-id, u32 group-id (STRS indices),
+ *       u8 flags (1 = locked, 2 = hidden, 4 = selected),
+ *       unique ids as (u32 length, bytes),
+ *       u32 other-properties (PROP index; 0xFFFFFFFF means empty).
+ *
+ * Readers skip chunks with unknown tags so later versions can add sections.
+ */
+
+static_assert(std::endian::native == std::endian::little, "The .edxb reader and writer assume a little-endian host");
+
+namespace edx
+{
+    namespace
+    {
+        constexpr char BINARY_MAGIC[4] = {'E', 'D', 'X', 'B'};
+        constexpr uint16_t BINARY_VERSION = 1;
+
+        constexpr uint32_t make_tag(const char a, const char b, const char c, const char d)
+        {
+            return static_cast<uint32_t>(a) | static_cast<uint32_t>(b) << 8 | static_cast<uint32_t>(c) << 16 | static_cast<uint32_t>(d) << 24;
+        }
+
+        constexpr uint32_t TAG_METADATA = make_tag('M', 'E', 'T', 'A');
+        constexpr uint32_t TAG_STRINGS = make_tag('S', 'T', 'R', 'S');
+        constexpr uint32_t TAG_PROPERTIES = make_tag('P', 'R', 'O', 'P');
+        constexpr uint32_t TAG_ASSETS = make_tag('A', 'S', 'E', 'T');
+
+        constexpr uint8_t FLAG_LOCKED = 1;
+        constexpr uint8_t FLAG_HIDDEN = 2;
+        constexpr uint8_t FLAG_SELECTED = 4;
+
+        // Smallest ASET entry: four doubles, four string indices, the flags,
+        // an empty unique id and the property index
+        constexpr size_t MIN_ASSET_RECORD_BYTES = 4 * sizeof(double) + 4 * sizeof(uint32_t) + sizeof(uint8_t) + 2 * sizeof(uint32_t);
+
+        [[noreturn]] void corrupt(const std::string& what)
+        {
+            throw std::runtime_error("Corrupt .edxb data: " + what);
+        }
+
+        // Little-endian byte buffer used to assemble one chunk
+        class ByteWriter
+        {
+        public:
+            template<typename T>
+            void pod(const T value)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                m_bytes.append(reinterpret_cast<const char*>(&value), sizeof(T));
+            }
+
+            void bytes(const void* data, const size_t size) { m_bytes.append(static_cast<const char*>(data), size); }
+
+            void string(const std::string_view val)
+            {
+                pod(static_cast<uint32_t>(val.size()));
+                bytes(val.data(), val.size());
+            }
+
+            std::string& buffer() { return m_bytes; }
+
+        private:
+            std::string m_bytes;
+        };
+
+        // Bounds-checked cursor over a chunk payload
+        class ByteReader
+        {
+        public:
+            explicit ByteReader(const std::string_view data) : m_cur(data.data()), m_end(data.data() + data.size()) { }
+
+            template<typename T>
+            T pod()
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                T value;
+                std::memcpy(&value, take(sizeof(T)), sizeof(T));
+                return value;
+            }
+
+            std::string_view bytes(const size_t size) { return {take(size), size}; }
+            std::string_view string() { return bytes(pod<uint32_t>()); }
+
+            // Copy a column of count values
+            template<typename T>
+            void column(std::vector<T>& out, const size_t count)
+            {
+                if (count > remaining() / sizeof(T))
+                    corrupt("column exceeds chunk size");
+
+                out.resize(count);
+                std::memcpy(out.data(), take(count * sizeof(T)), count * sizeof(T));
+            }
+
+            [[nodiscard]] size_t remaining() const { return static_cast<size_t>(m_end - m_cur); }
+
+        private:
+            const char* take(const size_t size)
+            {
+                if (size > remaining())
+                    corrupt("unexpected end of chunk");
+
+                const char* start = m_cur;
+                m_cur += size;
+                return start;
+            }
+
+            const char* m_cur;
+            const char* m_end;
+        };
+
+        // Assigns a stable index to each distinct string
+        class StringTable
+        {
+        public:
+            uint32_t intern(const std::string& val)
+            {
+                auto [it, inserted] = m_indices.try_emplace(val, static_cast<uint32_t>(m_strings.size()));
+                if (inserted)
+                    m_strings.push_back(&val);
+
+                return it->second;
+            }
+
+            void write(ByteWriter& writer) const
+            {
+                writer.pod(static_cast<uint32_t>(m_strings.size()));
+                for (const auto* str : m_strings)
+                    writer.string(*str);
+            }
+
+        private:
+            std::unordered_map<std::string_view, uint32_t> m_indices;
+            std::vector<const std::string*> m_strings;
+        };
+
+        void write_chunk(OutputSink& sink, const uint32_t tag, const std::string& payload)
+        {
+            ByteWriter header;
+            header.pod(tag);
+            header.pod(static_cast<uint64_t>(payload.size()));
+            sink.write(header.buffer().data(), header.buffer().size());
+            sink.write(payload.data(), payload.size());
+        }
+    }
+
+    void EdxProject::write_binary(OutputSink& sink, const SaveOptions& options) const
+    {
+        // META: small sections, stored as CBOR of their regular JSON form
+        json metadata;
+        project.to_json(metadata["Project"]);
+        airport.to_json(metadata["Airport"]);
+
+        json& librariesJson = metadata["Libraries"] = json::array();
+        for (const auto& lib : libraries)
+            lib.to_json(librariesJson.emplace_back());
+
+        json& layersJson = metadata["Layers"] = json::array();
+        for (const auto& layer : layers)
+            layer.to_json(layersJson.emplace_back());
+
+        if (!settings.empty())
+            metadata["Settings"] = settings;
+
+        ByteWriter metadataChunk;
+        json::to_cbor(metadata, metadataChunk.buffer());
+
+        // Assets in the order they are written
+        std::vector<const SceneAsset*> ordered;
+        ordered.reserve(assets.size());
+        if (options.spatialOrder)
+        {
+            for (const size_t index : hilbert_order(assets))
+                ordered.push_back(&assets[index]);
+        }
+        else
+        {
+            for (const auto& asset : assets)
+                ordered.push_back(&asset);
+        }
+
+        // ASET: one pass per column keeps each column contiguous in the output
+        const size_t count = assets.size();
+        StringTable strings;
+        ByteWriter assetChunk;
+        assetChunk.pod(static_cast<uint64_t>(count));
+
+        for (const SceneAsset* asset : ordered) assetChunk.pod(asset->latitude);
+        for (const SceneAsset* asset : ordered) assetChunk.pod(asset->longitude);
+        for (const SceneAsset* asset : ordered) assetChunk.pod(asset->altitude);
+        for (const SceneAsset* asset : ordered) assetChunk.pod(asset->heading);
+
+        for (const SceneAsset* asset : ordered) assetChunk.pod(strings.intern(asset->id));
+        for (const SceneAsset* asset : ordered) assetChunk.pod(strings.intern(asset->associatedLibrary));
+        for (const SceneAsset* asset : ordered) assetChunk.pod(strings.intern(asset->layerId));
+        for (const SceneAsset* asset : ordered) assetChunk.pod(strings.intern(asset->groupId));
+
+        for (const SceneAsset* asset : ordered)
+        {
+            const uint8_t flags = (asset->locked ? FLAG_LOCKED : 0) | (asset->hidden ? FLAG_HIDDEN : 0) | (asset->selected ? FLAG_SELECTED : 0);
+            assetChunk.pod(flags);
+        }
+
+        for (const SceneAsset* asset : ordered)
+            assetChunk.string(asset->uniqueId.str());
+
+        PropertyTable properties;
+        for (const SceneAsset* asset : ordered)
+            assetChunk.pod(asset->otherProperties.empty() ? PropertyTable::NONE : properties.add(asset->otherProperties));
+
+        ByteWriter stringChunk;
+        strings.write(stringChunk);
+
+        // PROP: each distinct blob once
+        ByteWriter propertyChunk;
+        propertyChunk.pod(static_cast<uint32_t>(properties.entries().size()));
+        std::string cbor;
+        for (const json* value : properties.entries())
+        {
+            cbor.clear();
+            json::to_cbor(*value, cbor);
+            propertyChunk.string(cbor);
+        }
+
+        ByteWriter header;
+        header.bytes(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+        header.pod(BINARY_VERSION);
+        header.pod(static_cast<uint16_t>(0));
+        sink.write(header.buffer().data(), header.buffer().size());
+
+        write_chunk(sink, TAG_METADATA, metadataChunk.buffer());
+        write_chunk(sink, TAG_STRINGS, stringChunk.buffer());
+        write_chunk(sink, TAG_PROPERTIES, propertyChunk.buffer());
+        write_chunk(sink, TAG_ASSETS, assetChunk.buffer());
+    }
+
+    namespace detail
+    {
+        BinaryChunks locate_binary_chunks(const std::string_view data)
+        {
+            if (!EdxProject::is_binary_data(data))
+                corrupt("missing EDXB signature");
+
+            ByteReader reader(data.substr(sizeof(BINARY_MAGIC)));
+            BinaryChunks chunks;
+            chunks.version = reader.pod<uint16_t>();
+            if (chunks.version == 0 || chunks.version > BINARY_VERSION)
+                throw std::runtime_error("Unsupported .edxb version " + std::to_string(chunks.version));
+            reader.pod<uint16_t>();
+
+            while (reader.remaining() > 0)
+            {
+                const auto tag = reader.pod<uint32_t>();
+                const auto size = reader.pod<uint64_t>();
+                if (size > reader.remaining())
+                    corrupt("chunk exceeds file size");
+
+                const std::string_view payload = reader.bytes(static_cast<size_t>(size));
+                if (tag == TAG_METADATA)
+                    chunks.metadata = payload;
+                else if (tag == TAG_STRINGS)
+                    chunks.strings = payload;
+                else if (tag == TAG_PROPERTIES)
+                    chunks.properties = payload;
+                else if (tag == TAG_ASSETS)
+                    chunks.assets = payload;
+            }
+
+            if (chunks.metadata.data() == nullptr)
+                corrupt("missing META chunk");
+
+            return chunks;
+        }
+
+        json decode_binary_metadata(const std::string_view chunk)
+        {
+            json metadata = json::from_cbor(chunk.begin(), chunk.end());
+            if (!metadata.is_object())
+                corrupt("META chunk is not an object");
+
+            return metadata;
+        }
+    }
+
+    void EdxProject::from_binary_buffer(const std::string_view data)
+    {
+        const detail::BinaryChunks chunks = detail::locate_binary_chunks(data);
+
+        // Decode everything before touching the project so errors leave it unchanged
+        const json metadata = detail::decode_binary_metadata(chunks.metadata);
+
+        std::vector<std::string> strings;
+        if (chunks.strings.data() != nullptr)
+        {
+            ByteReader stringReader(chunks.strings);
+            const auto count = stringReader.pod<uint32_t>();
+            if (count > stringReader.remaining() / sizeof(uint32_t))
+                corrupt("string table exceeds chunk size");
+
+            strings.reserve(count);
+            for (uint32_t i = 0; i < count; ++i)
+                strings.emplace_back(stringReader.string());
+        }
+
+        // Blobs are decoded once and shared by every asset that references them
+        PropertyPool propertyPool;
+        std::vector<SharedJson> properties;
+        if (chunks.properties.data() != nullptr)
+        {
+            ByteReader propertyReader(chunks.properties);
+            const auto count = propertyReader.pod<uint32_t>();
+            if (count > propertyReader.remaining() / sizeof(uint32_t))
+                corrupt("property table exceeds chunk size");
+
+            properties.reserve(count);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const std::string_view cbor = propertyReader.string();
+                properties.push_back(propertyPool.intern(json::from_cbor(cbor.begin(), cbor.end())));
+            }
+        }
+
+        std::vector<SceneAsset> decodedAssets;
+        if (chunks.assets.data() != nullptr)
+        {
+            ByteReader assetReader(chunks.assets);
+            const auto count64 = assetReader.pod<uint64_t>();
+            if (count64 > assetReader.remaining() / MIN_ASSET_RECORD_BYTES)
+                corrupt("asset count exceeds chunk size");
+
+            const auto count = static_cast<size_t>(count64);
+            decodedAssets.resize(count);
+
+            std::vector<double> doubles;
+            const auto read_doubles = [&](double SceneAsset::* field)
+            {
+                assetReader.column(doubles, count);
+                for (size_t i = 0; i < count; ++i)
+                    decodedAssets[i].*field = doubles[i];
+            };
+
+            read_doubles(&SceneAsset::latitude);
+            read_doubles(&SceneAsset::longitude);
+            read_doubles(&SceneAsset::altitude);
+            read_doubles(&SceneAsset::heading);
+
+            std::vector<uint32_t> indices;
+            const auto read_strings = [&]<typename Field>(Field SceneAsset::* field, const std::vector<Field>& table)
+            {
+                assetReader.column(indices, count);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (indices[i] >= table.size())
+                        corrupt("string index out of range");
+
+                    decodedAssets[i].*field = table[indices[i]];
+                }
+            };
+
+            // Intern each table entry once rather than once per asset
+            const std::vector<InternedString> internedStrings(strings.begin(), strings.end());
+
+            read_strings(&SceneAsset::id, strings);
+            read_strings(&SceneAsset::associatedLibrary, internedStrings);
+            read_strings(&SceneAsset::layerId, internedStrings);
+            read_strings(&SceneAsset::groupId, internedStrings);
+
+            std::vector<uint8_t> flags;
+            assetReader.column(flags, count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                decodedAssets[i].locked = (flags[i] & FLAG_LOCKED) != 0;
+                decodedAssets[i].hidden = (flags[i] & FLAG_HIDDEN) != 0;
+                decodedAssets[i].selected = (flags[i] & FLAG_SELECTED) != 0;
+            }
+
+            for (auto& asset : decodedAssets)
+                asset.uniqueId = assetReader.string();
+
+            assetReader.column(indices, count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (indices[i] == PropertyTable::NONE)
+                    continue;
+
+                if (indices[i] >= properties.size())
+                    corrupt("property index out of range");
+
+                decodedAssets[i].otherProperties = properties[indices[i]];
+            }
+        }
+
+        // The metadata sections can still fail to decode, so they go into a
+        // separate project that replaces this one only once all of it succeeded
+        EdxProject decoded;
+        decoded.from_json(metadata);
+        decoded.assets = std::move(decodedAssets);
+        *this = std::move(decoded);
+        invalidate_asset_indexes();
+    }
+
+    bool EdxProject::is_binary_data(const std::string_view leadingBytes)
+    {
+        return leadingBytes.size() >= sizeof(BINARY_MAGIC) + 2 * sizeof(uint16_t) &&
+               std::memcmp(leadingBytes.data(), BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0;
+    }
+
+    bool EdxProject::save_to_binary_file(const std::filesystem::path& filePath, const SaveOptions& options) const
+    {
+        try
+        {
+            AtomicFileWriter file(filePath, options.durability);
+            write_binary(file, options);
+            file.commit();
+
+            std::cout << "Successfully saved binary project to: " << filePath << '\n';
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Error saving binary project file: " << e.what() << '\n';
+            return false;
+        }
+    }
+
+    bool EdxProject::load_from_binary_file(const std::filesystem::path& filePath)
+    {
+        try
+        {
+            if (!std::filesystem::exists(filePath))
+            {
+                std::cerr << "Error: File does not exist: " << filePath << '\n';
+                return false;
+            }
+
+            const auto file = MappedFile::open(filePath);
+            from_binary_buffer(file->view());
+
+            std::cout << "Successfully loaded binary project from: " << filePath << '\n';
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Error loading binary project file: " << e.what() << '\n';
+            return false;
+        }
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
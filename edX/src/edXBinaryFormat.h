@@ -0,0 +1,53 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXBinaryFormat.h
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include <edX/config/edXConfig.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx::detail
+{
+    // Chunk payloads of an .edxb document; a chunk that is absent has a null data()
+    struct BinaryChunks
+    {
+        uint16_t version = 0;
+        std::string_view metadata;
+        std::string_view strings;
+        std::string_view properties;
+        std::string_view assets;
+    };
+
+    // Validate the .edxb header and locate the known chunks. Throws on corrupt data.
+    BinaryChunks locate_binary_chunks(std::string_view data);
+
+    // Decode the META chunk: Project, Airport, Libraries, Layers and Settings as JSON
+    json decode_binary_metadata(std::string_view chunk);
+
+} // namespace edx::detail
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,177 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXCompression.cpp
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <edX/src/edXCompression.h>
+
+#if defined(EDX_HAS_ZSTD)
+    #include <zstd.h>
+#endif
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    bool is_compression_available()
+    {
+#if defined(EDX_HAS_ZSTD)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    namespace detail
+    {
+        bool is_compressed(const std::string_view leadingBytes)
+        {
+            // zstd frame magic number 0xFD2FB528, stored little-endian
+            return leadingBytes.size() >= 4 && std::memcmp(leadingBytes.data(), "\x28\xB5\x2F\xFD", 4) == 0;
+        }
+
+#if defined(EDX_HAS_ZSTD)
+
+        namespace
+        {
+            size_t check(const size_t result, const char* operation)
+            {
+                if (ZSTD_isError(result))
+                    throw std::runtime_error(std::string(operation) + " failed: " + ZSTD_getErrorName(result));
+
+                return result;
+            }
+        }
+
+        CompressingSink::CompressingSink(OutputSink& target, const int level)
+            : m_target(target), m_context(ZSTD_createCCtx()), m_buffer(ZSTD_CStreamOutSize())
+        {
+            if (m_context == nullptr)
+                throw std::runtime_error("Failed to create zstd compression context");
+
+            auto* context = static_cast<ZSTD_CCtx*>(m_context);
+            check(ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, level), "Setting compression level");
+            check(ZSTD_CCtx_setParameter(context, ZSTD_c_checksumFlag, 1), "Enabling checksums");
+        }
+
+        CompressingSink::~CompressingSink()
+        {
+            ZSTD_freeCCtx(static_cast<ZSTD_CCtx*>(m_context));
+        }
+
+        void CompressingSink::write(const char* data, const size_t size)
+        {
+            ZSTD_inBuffer input{data, size, 0};
+            while (input.pos < input.size)
+            {
+                ZSTD_outBuffer output{m_buffer.data(), m_buffer.size(), 0};
+                check(ZSTD_compressStream2(static_cast<ZSTD_CCtx*>(m_context), &output, &input, ZSTD_e_continue), "Compression");
+                if (output.pos > 0)
+                    m_target.write(m_buffer.data(), output.pos);
+            }
+        }
+
+        void CompressingSink::finish()
+        {
+            ZSTD_inBuffer input{nullptr, 0, 0};
+            size_t remaining;
+            do
+            {
+                ZSTD_outBuffer output{m_buffer.data(), m_buffer.size(), 0};
+                remaining = check(ZSTD_compressStream2(static_cast<ZSTD_CCtx*>(m_context), &output, &input, ZSTD_e_end), "Compression");
+                if (output.pos > 0)
+                    m_target.write(m_buffer.data(), output.pos);
+            }
+            while (remaining != 0);
+        }
+
+        DecompressingStreamBuf::DecompressingStreamBuf(const std::string_view compressed)
+            : m_input(compressed), m_context(ZSTD_createDCtx()), m_buffer(ZSTD_DStreamOutSize())
+        {
+            if (m_context == nullptr)
+                throw std::runtime_error("Failed to create zstd decompression context");
+        }
+
+        DecompressingStreamBuf::~DecompressingStreamBuf()
+        {
+            ZSTD_freeDCtx(static_cast<ZSTD_DCtx*>(m_context));
+        }
+
+        DecompressingStreamBuf::int_type DecompressingStreamBuf::underflow()
+        {
+            if (gptr() < egptr())
+                return traits_type::to_int_type(*gptr());
+
+            while (m_inputPos < m_input.size() || m_frameRemaining != 0)
+            {
+                ZSTD_inBuffer input{m_input.data(), m_input.size(), m_inputPos};
+                ZSTD_outBuffer output{m_buffer.data(), m_buffer.size(), 0};
+                m_frameRemaining = check(ZSTD_decompressStream(static_cast<ZSTD_DCtx*>(m_context), &output, &input), "Decompression");
+
+                const bool stalled = input.pos == m_inputPos && output.pos == 0;
+                m_inputPos = input.pos;
+
+                if (output.pos > 0)
+                {
+                    setg(m_buffer.data(), m_buffer.data(), m_buffer.data() + output.pos);
+                    return traits_type::to_int_type(*gptr());
+                }
+
+                if (stalled)
+                    break;
+            }
+
+            if (m_frameRemaining != 0)
+                throw std::runtime_error("Compressed data is truncated");
+
+            return traits_type::eof();
+        }
+
+#else
+
+        CompressingSink::CompressingSink(OutputSink& target, int) : m_target(target)
+        {
+            throw std::runtime_error("edX was built without zstd support; compressed files cannot be written");
+        }
+
+        CompressingSink::~CompressingSink() = default;
+        void CompressingSink::write(const char*, size_t) { }
+        void CompressingSink::finish() { }
+
+        DecompressingStreamBuf::DecompressingStreamBuf(const std::string_view compressed) : m_input(compressed)
+        {
+            throw std::runtime_error("edX was built without zstd support; compressed files cannot be read");
+        }
+
+        DecompressingStreamBuf::~DecompressingStreamBuf() = default;
+        DecompressingStreamBuf::int_type DecompressingStreamBuf::underflow() { return traits_type::eof(); }
+
+#endif
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
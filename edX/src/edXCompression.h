@@ -0,0 +1,110 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXCompression.h
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <streambuf>
+#include <string_view>
+#include <vector>
+#include <edX/config/edXConfig.h>
+#include <edX/include/edXFileIO.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx::detail
+{
+    // True if the data starts with a zstd frame
+    [[nodiscard]] bool is_compressed(std::string_view leadingBytes);
+
+    /**
+     * @brief OutputSink that zstd-compresses into another sink
+     *
+     * Data is compressed as it arrives; only one output block is held in
+     * memory. finish() must be called to end the frame.
+     */
+    class CompressingSink final : public OutputSink
+    {
+    public:
+        // Throws std::runtime_error if zstd support was not compiled in
+        CompressingSink(OutputSink& target, int level);
+        ~CompressingSink() override;
+
+        CompressingSink(const CompressingSink&) = delete;
+        CompressingSink& operator=(const CompressingSink&) = delete;
+
+        void write(const char* data, size_t size) override;
+        void finish();
+
+    private:
+        OutputSink& m_target;
+        void* m_context = nullptr;
+        std::vector<char> m_buffer;
+    };
+
+    /**
+     * @brief Read-only stream buffer that decompresses zstd data on demand
+     *
+     * Wrap in a std::istream to feed a parser; only one decompressed block is
+     * held in memory at a time. Corrupt or truncated input throws
+     * std::runtime_error from the read that hits it.
+     */
+    class DecompressingStreamBuf final : public std::streambuf
+    {
+    public:
+        // Throws std::runtime_error if zstd support was not compiled in
+        explicit DecompressingStreamBuf(std::string_view compressed);
+        ~DecompressingStreamBuf() override;
+
+        DecompressingStreamBuf(const DecompressingStreamBuf&) = delete;
+        DecompressingStreamBuf& operator=(const DecompressingStreamBuf&) = delete;
+
+    protected:
+        int_type underflow() override;
+
+    private:
+        std::string_view m_input;
+        size_t m_inputPos = 0;
+        size_t m_frameRemaining = 0;
+        void* m_context = nullptr;
+        std::vector<char> m_buffer;
+    };
+
+    // Run writer against target, compressing in between when the options ask for it
+    template<typename Writer>
+    void write_with_compression(OutputSink& target, const SaveOptions& options, Writer&& writer)
+    {
+        if (options.compression == Compression::None)
+        {
+            writer(target);
+            return;
+        }
+
+        CompressingSink compressed(target, options.compressionLevel);
+        writer(compressed);
+        compressed.finish();
+    }
+
+} // namespace edx::detail
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,389 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXFileIO.cpp
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <edX/include/edXFileIO.h>
+
+#if defined(EDX_PLATFORM_WINDOWS)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    void StreamSink::write(const char* data, const size_t size)
+    {
+        m_stream.write(data, static_cast<std::streamsize>(size));
+        if (!m_stream)
+            throw std::runtime_error("Failed to write to output stream");
+    }
+
+    //////////////////////////////////////////////////////
+
+    namespace
+    {
+        // Sibling of the target so the final rename never crosses filesystems
+        std::filesystem::path make_temp_path(const std::filesystem::path& targetPath)
+        {
+            std::random_device device;
+            char suffix[16];
+            std::snprintf(suffix, sizeof(suffix), ".%08x.tmp", device());
+
+            std::filesystem::path tempPath = targetPath;
+            tempPath += suffix;
+            return tempPath;
+        }
+    }
+
+    AtomicFileWriter::AtomicFileWriter(std::filesystem::path targetPath, const Durability durability, const size_t bufferSize)
+        : m_targetPath(std::move(targetPath)), m_tempPath(make_temp_path(m_targetPath)), m_durability(durability),
+          m_buffer(std::max<size_t>(bufferSize, 1))
+    {
+#if defined(EDX_PLATFORM_WINDOWS)
+        const HANDLE handle = CreateFileW(m_tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_NEW,
+                                          FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (handle == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("Cannot open file for writing: " + m_tempPath.string());
+
+        m_file = reinterpret_cast<intptr_t>(handle);
+#else
+        // Keep the permissions of the file being replaced
+        mode_t mode = 0666;
+        if (struct stat status{}; ::stat(m_targetPath.c_str(), &status) == 0)
+            mode = status.st_mode & 07777;
+
+        m_file = ::open(m_tempPath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, mode);
+        if (m_file < 0)
+            throw std::runtime_error("Cannot open file for writing: " + m_tempPath.string() + " (" + std::strerror(errno) + ")");
+
+        if (mode != 0666)
+            ::fchmod(static_cast<int>(m_file), mode);
+#endif
+    }
+
+    AtomicFileWriter::~AtomicFileWriter()
+    {
+        if (m_committed)
+            return;
+
+        close_file();
+        std::error_code ec;
+        std::filesystem::remove(m_tempPath, ec);
+    }
+
+    void AtomicFileWriter::write(const char* data, const size_t size)
+    {
+        if (m_used + size > m_buffer.size())
+        {
+            flush_buffer();
+
+            // Large blocks skip the buffer entirely
+            if (size >= m_buffer.size())
+            {
+                write_direct(data, size);
+                return;
+            }
+        }
+
+        std::memcpy(m_buffer.data() + m_used, data, size);
+        m_used += size;
+    }
+
+    void AtomicFileWriter::flush_buffer()
+    {
+        if (m_used == 0)
+            return;
+
+        write_direct(m_buffer.data(), m_used);
+        m_used = 0;
+    }
+
+    void AtomicFileWriter::commit()
+    {
+        if (m_committed)
+            return;
+
+        flush_buffer();
+
+#if defined(EDX_PLATFORM_WINDOWS)
+        const auto handle = reinterpret_cast<HANDLE>(m_file);
+        if (m_durability != Durability::None && !FlushFileBuffers(handle))
+            throw std::runtime_error("Failed to sync file: " + m_tempPath.string());
+
+        close_file();
+
+        DWORD flags = MOVEFILE_REPLACE_EXISTING;
+        if (m_durability == Durability::Full)
+            flags |= MOVEFILE_WRITE_THROUGH;
+
+        if (!MoveFileExW(m_tempPath.c_str(), m_targetPath.c_str(), flags))
+            throw std::runtime_error("Failed to replace file: " + m_targetPath.string());
+#else
+        const int fd = static_cast<int>(m_file);
+        if (m_durability == Durability::Data)
+        {
+#if defined(EDX_PLATFORM_LINUX)
+            const int result = ::fdatasync(fd);
+#else
+            const int result = ::fsync(fd);
+#endif
+            if (result != 0)
+                throw std::runtime_error("Failed to sync file: " + m_tempPath.string());
+        }
+        else if (m_durability == Durability::Full && ::fsync(fd) != 0)
+        {
+            throw std::runtime_error("Failed to sync file: " + m_tempPath.string());
+        }
+
+        if (::close(fd) != 0)
+        {
+            m_file = -1;
+            throw std::runtime_error("Failed to close file: " + m_tempPath.string());
+        }
+        m_file = -1;
+
+        if (::rename(m_tempPath.c_str(), m_targetPath.c_str()) != 0)
+            throw std::runtime_error("Failed to replace file: " + m_targetPath.string() + " (" + std::strerror(errno) + ")");
+
+        // Persist the rename itself by syncing the containing directory
+        if (m_durability == Durability::Full)
+        {
+            const auto parent = m_targetPath.has_parent_path() ? m_targetPath.parent_path() : std::filesystem::path(".");
+            if (const int dirFd = ::open(parent.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC); dirFd >= 0)
+            {
+                ::fsync(dirFd);
+                ::close(dirFd);
+            }
+        }
+#endif
+
+        m_committed = true;
+    }
+
+    void AtomicFileWriter::write_direct(const char* data, size_t size)
+    {
+#if defined(EDX_PLATFORM_WINDOWS)
+        const auto handle = reinterpret_cast<HANDLE>(m_file);
+        while (size > 0)
+        {
+            const DWORD chunk = static_cast<DWORD>(std::min<size_t>(size, 1u << 30));
+            DWORD written = 0;
+            if (!WriteFile(handle, data, chunk, &written, nullptr))
+                throw std::runtime_error("Failed to write file: " + m_tempPath.string());
+
+            data += written;
+            size -= written;
+        }
+#else
+        while (size > 0)
+        {
+            const ssize_t written = ::write(static_cast<int>(m_file), data, size);
+            if (written < 0 && errno == EINTR)
+                continue;
+
+            if (written < 0)
+                throw std::runtime_error("Failed to write file: " + m_tempPath.string() + " (" + std::strerror(errno) + ")");
+
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+#endif
+    }
+
+    void AtomicFileWriter::close_file()
+    {
+        if (m_file == -1)
+            return;
+
+#if defined(EDX_PLATFORM_WINDOWS)
+        CloseHandle(reinterpret_cast<HANDLE>(m_file));
+#else
+        ::close(static_cast<int>(m_file));
+#endif
+        m_file = -1;
+    }
+
+    //////////////////////////////////////////////////////
+
+#if defined(EDX_PLATFORM_WINDOWS)
+
+    namespace
+    {
+        // Closes a Win32 handle when the scope ends
+        struct HandleGuard
+        {
+            HANDLE handle;
+            ~HandleGuard()
+            {
+                if (handle != nullptr && handle != INVALID_HANDLE_VALUE)
+                    CloseHandle(handle);
+            }
+        };
+    }
+
+    std::shared_ptr<const MappedFile> MappedFile::open(const std::filesystem::path& filePath)
+    {
+        std::shared_ptr<MappedFile> file(new MappedFile());
+
+        HandleGuard fileHandle{CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                           FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr)};
+        if (fileHandle.handle == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("Cannot open file for reading: " + filePath.string());
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle.handle, &fileSize))
+            throw std::runtime_error("Cannot determine file size: " + filePath.string());
+
+        file->m_size = static_cast<size_t>(fileSize.QuadPart);
+        if (file->m_size == 0)
+            return file;
+
+        HandleGuard mapping{CreateFileMappingW(fileHandle.handle, nullptr, PAGE_READONLY, 0, 0, nullptr)};
+        if (mapping.handle != nullptr)
+        {
+            if (void* view = MapViewOfFile(mapping.handle, FILE_MAP_READ, 0, 0, 0))
+            {
+                file->m_data = static_cast<const char*>(view);
+                file->m_mapped = true;
+                return file;
+            }
+        }
+
+        // Mapping unavailable; read the file into memory instead
+        file->m_buffer.resize(file->m_size);
+        size_t offset = 0;
+        while (offset < file->m_size)
+        {
+            const DWORD chunk = static_cast<DWORD>(std::min<size_t>(file->m_size - offset, 1u << 30));
+            DWORD bytesRead = 0;
+            if (!ReadFile(fileHandle.handle, file->m_buffer.data() + offset, chunk, &bytesRead, nullptr) || bytesRead == 0)
+                throw std::runtime_error("Failed to read file: " + filePath.string());
+
+            offset += bytesRead;
+        }
+
+        file->m_data = file->m_buffer.data();
+        return file;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (m_mapped)
+            UnmapViewOfFile(m_data);
+    }
+
+#else
+
+    namespace
+    {
+        // Closes a file descriptor when the scope ends
+        struct DescriptorGuard
+        {
+            int fd;
+            ~DescriptorGuard()
+            {
+                if (fd >= 0)
+                    ::close(fd);
+            }
+        };
+    }
+
+    std::shared_ptr<const MappedFile> MappedFile::open(const std::filesystem::path& filePath)
+    {
+        std::shared_ptr<MappedFile> file(new MappedFile());
+
+        DescriptorGuard descriptor{::open(filePath.c_str(), O_RDONLY | O_CLOEXEC)};
+        if (descriptor.fd < 0)
+            throw std::runtime_error("Cannot open file for reading: " + filePath.string() + " (" + std::strerror(errno) + ")");
+
+        struct stat status{};
+        if (::fstat(descriptor.fd, &status) != 0)
+            throw std::runtime_error("Cannot determine file size: " + filePath.string());
+
+        file->m_size = static_cast<size_t>(status.st_size);
+        if (file->m_size == 0)
+            return file;
+
+        void* view = ::mmap(nullptr, file->m_size, PROT_READ, MAP_PRIVATE, descriptor.fd, 0);
+        if (view != MAP_FAILED)
+        {
+            // Loaders scan front to back; let the kernel read ahead aggressively
+            ::madvise(view, file->m_size, MADV_SEQUENTIAL);
+
+            file->m_data = static_cast<const char*>(view);
+            file->m_mapped = true;
+            return file;
+        }
+
+        // Mapping unavailable; read the file into memory instead
+        file->m_buffer.resize(file->m_size);
+        size_t offset = 0;
+        while (offset < file->m_size)
+        {
+            const ssize_t bytesRead = ::pread(descriptor.fd, file->m_buffer.data() + offset, file->m_size - offset,
+                                              static_cast<off_t>(offset));
+            if (bytesRead < 0 && errno == EINTR)
+                continue;
+
+            if (bytesRead <= 0)
+                throw std::runtime_error("Failed to read file: " + filePath.string());
+
+            offset += static_cast<size_t>(bytesRead);
+        }
+
+        file->m_data = file->m_buffer.data();
+        return file;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (m_mapped)
+            ::munmap(const_cast<char*>(m_data), m_size);
+    }
+
+#endif
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
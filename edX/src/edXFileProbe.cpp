@@ -0,0 +1,318 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXFileProbe.cpp
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <istream>
+#include <map>
+#include <edX/include/edXFileIO.h>
+#include <edX/include/edXLibraryFile.h>
+#include <edX/include/edXProjectFile.h>
+#include <edX/src/edXBinaryFormat.h>
+#include <edX/src/edXCompression.h>
+#include <edX/src/edXJsonSax.h>
+#include <edX/src/edXJsonSkim.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    namespace
+    {
+        // Sections that hold arrays in a valid file; checked by their first byte only
+        bool is_array_section(const std::string& key)
+        {
+            return key == "Assets" || key == "Layers" || key == "Libraries" || key == "Objects";
+        }
+
+        /**
+         * SAX consumer that captures selected top-level sections of a streamed
+         * document. Compressed files cannot be skimmed, so this is the probe's
+         * fallback: it stops the parse as soon as every wanted section is read.
+         */
+        class SectionCapture
+        {
+        public:
+            explicit SectionCapture(std::vector<std::string> wanted) : m_wanted(std::move(wanted)) {}
+
+            std::map<std::string, json> sections;
+            bool invalid = false;
+
+            bool null() { return scalar([&] { return m_builder.null(); }); }
+            bool boolean(bool val) { return scalar([&] { return m_builder.boolean(val); }); }
+            bool number_integer(json::number_integer_t val) { return scalar([&] { return m_builder.number_integer(val); }); }
+            bool number_unsigned(json::number_unsigned_t val) { return scalar([&] { return m_builder.number_unsigned(val); }); }
+            bool number_float(json::number_float_t val, const json::string_t& s) { return scalar([&] { return m_builder.number_float(val, s); }); }
+            bool string(json::string_t& val) { return scalar([&] { return m_builder.string(val); }); }
+            bool binary(json::binary_t& val) { return scalar([&] { return m_builder.binary(val); }); }
+
+            bool start_object(std::size_t elements)
+            {
+                return open([&] { return m_builder.start_object(elements); }, false);
+            }
+
+            bool start_array(std::size_t elements)
+            {
+                return open([&] { return m_builder.start_array(elements); }, true);
+            }
+
+            bool key(json::string_t& val)
+            {
+                if (m_capturing)
+                    return m_builder.key(val);
+
+                if (m_depth == 1)
+                    m_key = val;
+                return true;
+            }
+
+            bool end_object() { return close([&] { return m_builder.end_object(); }); }
+            bool end_array() { return close([&] { return m_builder.end_array(); }); }
+
+            bool parse_error(std::size_t, const std::string&, const json::exception&)
+            {
+                invalid = true;
+                return false;
+            }
+
+        private:
+            template<typename Forward>
+            bool scalar(Forward&& forward)
+            {
+                if (m_capturing)
+                    return forward() && finish_if_complete();
+
+                // A scalar root or an array section holding a scalar is not an edX file
+                if (m_depth == 0 || (m_depth == 1 && is_array_section(m_key)))
+                {
+                    invalid = true;
+                    return false;
+                }
+
+                if (m_depth == 1 && is_wanted(m_key))
+                {
+                    m_builder.reset();
+                    return forward() && finish_if_complete();
+                }
+                return true;
+            }
+
+            template<typename Forward>
+            bool open(Forward&& forward, const bool isArray)
+            {
+                if (m_capturing)
+                    return forward();
+
+                if (m_depth == 0 && isArray)
+                {
+                    invalid = true;
+                    return false;
+                }
+
+                if (m_depth == 1)
+                {
+                    if (is_array_section(m_key) && !isArray)
+                    {
+                        invalid = true;
+                        return false;
+                    }
+
+                    if (is_wanted(m_key))
+                    {
+                        m_builder.reset();
+                        m_capturing = true;
+                        return forward();
+                    }
+                }
+
+                ++m_depth;
+                return true;
+            }
+
+            template<typename Forward>
+            bool close(Forward&& forward)
+            {
+                if (m_capturing)
+                    return forward() && finish_if_complete();
+
+                --m_depth;
+                return true;
+            }
+
+            bool finish_if_complete()
+            {
+                if (!m_builder.complete())
+                    return true;
+
+                m_capturing = false;
+                sections[m_key] = std::move(m_builder.result());
+
+                // Returning false stops the parser; the rest of the file is never read
+                return sections.size() < m_wanted.size();
+            }
+
+            [[nodiscard]] bool is_wanted(const std::string& key) const
+            {
+                return std::ranges::find(m_wanted, key) != m_wanted.end() && !sections.contains(key);
+            }
+
+            std::vector<std::string> m_wanted;
+            detail::JsonDomBuilder m_builder;
+            std::string m_key;
+            int m_depth = 0;
+            bool m_capturing = false;
+        };
+
+        // Stream a compressed document until the wanted top-level sections are read
+        std::optional<std::map<std::string, json>> read_compressed_sections(const std::string_view data, std::vector<std::string> wanted)
+        {
+            detail::DecompressingStreamBuf buffer(data);
+            std::istream stream(&buffer);
+
+            SectionCapture capture(std::move(wanted));
+            json::sax_parse(stream, &capture, json::input_format_t::json, false);
+            if (capture.invalid)
+                return std::nullopt;
+
+            return std::move(capture.sections);
+        }
+    }
+
+    std::optional<ProjectFileHeader> ProjectFileHeader::probe(const std::filesystem::path& filePath)
+    {
+        try
+        {
+            // Pages are only faulted in as the skimmer reaches them
+            const auto file = MappedFile::open(filePath);
+            ProjectFileHeader header;
+
+            if (EdxProject::is_binary_data(file->view()))
+            {
+                const json metadata = detail::decode_binary_metadata(detail::locate_binary_chunks(file->view()).metadata);
+                if (!metadata.contains("Project"))
+                    return std::nullopt;
+
+                header.project.from_json(metadata["Project"]);
+                if (metadata.contains("Airport"))
+                    header.airport.from_json(metadata["Airport"]);
+
+                header.binary = true;
+                return header;
+            }
+
+            if (detail::is_compressed(file->view()))
+            {
+                const auto sections = read_compressed_sections(file->view(), {"Project", "Airport"});
+                if (!sections || !sections->contains("Project"))
+                    return std::nullopt;
+
+                header.project.from_json(sections->at("Project"));
+                if (sections->contains("Airport"))
+                    header.airport.from_json(sections->at("Airport"));
+
+                return header;
+            }
+
+            detail::JsonSkimmer skimmer(file->view());
+            if (!skimmer.begin_object())
+                return std::nullopt;
+
+            bool hasProject = false, hasAirport = false;
+            std::string key;
+            while (!(hasProject && hasAirport) && skimmer.next_key(key))
+            {
+                const std::string_view value = skimmer.skip_value();
+                if (key == "Project")
+                {
+                    header.project.from_json(json::parse(value));
+                    hasProject = true;
+                }
+                else if (key == "Airport")
+                {
+                    header.airport.from_json(json::parse(value));
+                    hasAirport = true;
+                }
+                else if (is_array_section(key) && value.front() != '[')
+                {
+                    return std::nullopt;
+                }
+            }
+
+            if (!hasProject)
+                return std::nullopt;
+
+            return header;
+        }
+        catch (const std::exception&)
+        {
+            return std::nullopt;
+        }
+    }
+
+    std::optional<LibraryFileHeader> LibraryFileHeader::probe(const std::filesystem::path& filePath)
+    {
+        try
+        {
+            const auto file = MappedFile::open(filePath);
+            if (detail::is_compressed(file->view()))
+            {
+                const auto sections = read_compressed_sections(file->view(), {"Library"});
+                if (!sections || !sections->contains("Library"))
+                    return std::nullopt;
+
+                LibraryFileHeader header;
+                header.library.from_json(sections->at("Library"));
+                return header;
+            }
+
+            detail::JsonSkimmer skimmer(file->view());
+            if (!skimmer.begin_object())
+                return std::nullopt;
+
+            std::string key;
+            while (skimmer.next_key(key))
+            {
+                const std::string_view value = skimmer.skip_value();
+                if (key == "Library")
+                {
+                    LibraryFileHeader header;
+                    header.library.from_json(json::parse(value));
+                    return header;
+                }
+
+                if (is_array_section(key) && value.front() != '[')
+                    return std::nullopt;
+            }
+
+            return std::nullopt;
+        }
+        catch (const std::exception&)
+        {
+            return std::nullopt;
+        }
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
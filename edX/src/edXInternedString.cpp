@@ -0,0 +1,122 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXInternedString.cpp
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+#include <edX/include/edXInternedString.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    namespace
+    {
+        using detail::PooledString;
+
+        struct TransparentHash
+        {
+            using is_transparent = void;
+            size_t operator()(const std::string_view text) const noexcept { return std::hash<std::string_view>{}(text); }
+            size_t operator()(const PooledString& entry) const noexcept { return (*this)(entry.text); }
+        };
+
+        struct TransparentEqual
+        {
+            using is_transparent = void;
+            static std::string_view text(const std::string_view value) { return value; }
+            static std::string_view text(const PooledString& entry) { return entry.text; }
+
+            template<typename A, typename B>
+            bool operator()(const A& a, const B& b) const noexcept { return text(a) == text(b); }
+        };
+
+        // Node-based set: pooled strings never move once inserted. An entry is
+        // only erased under the unique lock once its count has reached zero
+        struct StringPool
+        {
+            std::shared_mutex mutex;
+            std::unordered_set<PooledString, TransparentHash, TransparentEqual> strings;
+        };
+
+        StringPool& pool()
+        {
+            // Never destroyed, so handles held by static objects outlive shutdown order
+            static auto* instance = new StringPool;
+            return *instance;
+        }
+
+        const PooledString* intern(const std::string_view text)
+        {
+            if (text.empty())
+                return nullptr;
+
+            StringPool& shared = pool();
+            {
+                std::shared_lock lock(shared.mutex);
+                if (const auto it = shared.strings.find(text); it != shared.strings.end())
+                {
+                    it->references.fetch_add(1, std::memory_order_relaxed);
+                    return &*it;
+                }
+            }
+
+            std::unique_lock lock(shared.mutex);
+            const PooledString& entry = *shared.strings.emplace(text).first;
+            entry.references.fetch_add(1, std::memory_order_relaxed);
+            return &entry;
+        }
+    }
+
+    InternedString::InternedString(const std::string_view text) : m_entry(intern(text)) {}
+
+    void InternedString::release(const PooledString* entry) noexcept
+    {
+        // Dropping a handle that is not the last one needs no lock
+        size_t count = entry->references.load(std::memory_order_relaxed);
+        while (count > 1)
+        {
+            if (entry->references.compare_exchange_weak(count, count - 1, std::memory_order_release, std::memory_order_relaxed))
+                return;
+        }
+
+        // Possibly the last handle: decide under the unique lock so no lookup
+        // can revive the entry between the final decrement and the erase
+        StringPool& shared = pool();
+        std::unique_lock lock(shared.mutex);
+        if (entry->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            shared.strings.erase(shared.strings.find(entry->text));
+    }
+
+    size_t InternedString::pool_size()
+    {
+        StringPool& shared = pool();
+        std::shared_lock lock(shared.mutex);
+        return shared.strings.size();
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
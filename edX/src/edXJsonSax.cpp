@@ -0,0 +1,737 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXJsonSax.cpp
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#include <stdexcept>
+#include <string>
+#include <edX/src/edXJsonSax.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx::detail
+{
+    namespace
+    {
+        // Rethrow parser errors with their original type so callers can keep catching json::parse_error
+        [[noreturn]] void rethrow_parse_error(const json::exception& ex)
+        {
+            if (ex.id >= 100 && ex.id < 200)
+                throw *static_cast<const json::parse_error*>(&ex);
+
+            if (ex.id >= 400 && ex.id < 500)
+                throw *static_cast<const json::out_of_range*>(&ex);
+
+            throw std::runtime_error(ex.what());
+        }
+
+        // Mirrors the DOM loop in EdxProject::from_json for sections that are not plain arrays
+        template<typename T>
+        void apply_dom_section(std::vector<T>& target, const json& value)
+        {
+            target.clear();
+            for (const auto& itemJson : value)
+            {
+                T item;
+                item.from_json(itemJson);
+                target.push_back(std::move(item));
+            }
+        }
+    }
+
+    //////////////////////////////////////////////////////
+    // JsonDomBuilder
+    //////////////////////////////////////////////////////
+
+    void JsonDomBuilder::reset()
+    {
+        m_root = json();
+        m_stack.clear();
+        m_keySlot = nullptr;
+        m_complete = false;
+    }
+
+    template<typename Value>
+    json* JsonDomBuilder::insert(Value&& val)
+    {
+        if (m_stack.empty())
+        {
+            m_root = json(std::forward<Value>(val));
+            return &m_root;
+        }
+
+        json* parent = m_stack.back();
+        if (parent->is_array())
+        {
+            parent->emplace_back(std::forward<Value>(val));
+            return &parent->back();
+        }
+
+        *m_keySlot = json(std::forward<Value>(val));
+        return m_keySlot;
+    }
+
+    bool JsonDomBuilder::null()
+    {
+        insert(nullptr);
+        m_complete = m_stack.empty();
+        return true;
+    }
+
+    bool JsonDomBuilder::boolean(const bool val)
+    {
+        insert(val);
+        m_complete = m_stack.empty();
+        return true;
+    }
+
+    bool JsonDomBuilder::number_integer(const json::number_integer_t val)
+    {
+        insert(val);
+        m_complete = m_stack.empty();
+        return true;
+    }
+
+    bool JsonDomBuilder::number_unsigned(const json::number_unsigned_t val)
+    {
+        insert(val);
+        m_complete = m_stack.empty();
+        return true;
+    }
+
+    bool JsonDomBuilder::number_float(const json::number_float_t val, const json::string_t&)
+    {
+        insert(val);
+        m_complete = m_stack.empty();
+        return true;
+    }
+
+    bool JsonDomBuilder::string(json::string_t& val)
+    {
+        insert(std::move(val));
+        m_complete = m_stack.empty();
+        return true;
+    }
+
+    bool JsonDomBuilder::binary(json::binary_t& val)
+    {
+        insert(std::move(val));
+        m_complete = m_stack.empty();
+        return true;
+    }
+
+    bool JsonDomBuilder::start_object(std::size_t)
+    {
+        m_stack.push_back(insert(json::value_t::object));
+        return true;
+    }
+
+    bool JsonDomBuilder::key(json::string_t& val)
+    {
+        m_keySlot = &(*m_stack.back())[val];
+        return true;
+    }
+
+    bool JsonDomBuilder::end_object()
+    {
+        m_stack.pop_back();
+        m_complete = m_stack.empty();
+        return true;
+    }
+
+    bool JsonDomBuilder::start_array(std::size_t)
+    {
+        m_stack.push_back(insert(json::value_t::array));
+        return true;
+    }
+
+    bool JsonDomBuilder::end_array()
+    {
+        m_stack.pop_back();
+        m_complete = m_stack.empty();
+        return true;
+    }
+
+    bool JsonDomBuilder::parse_error(std::size_t, const std::string&, const json::exception& ex)
+    {
+        rethrow_parse_error(ex);
+    }
+
+    //////////////////////////////////////////////////////
+    // ProjectSections
+    //////////////////////////////////////////////////////
+
+    void ProjectSections::resolve_property_refs(const std::span<SceneAsset> target)
+    {
+        if (propertyRefs.empty())
+            return;
+
+        if (!propertyTable)
+            throw std::runtime_error("Project has other-properties-ref values but no Property-Table");
+
+        const std::vector<SharedJson> table = load_property_table(std::move(*propertyTable), properties);
+        propertyTable.reset();
+
+        for (const auto& ref : propertyRefs)
+            target[ref.asset].otherProperties = property_table_entry(table, ref.index);
+
+        propertyRefs.clear();
+    }
+
+    void ProjectSections::commit(EdxProject& target)
+    {
+        // Resolved first so a bad reference leaves the target untouched
+        resolve_property_refs(assets);
+
+        if (project)
+            target.project.from_json(*project);
+
+        if (airport)
+            target.airport.from_json(*airport);
+
+        target.libraries = std::move(libraries);
+        target.assets = std::move(assets);
+        target.invalidate_asset_indexes();
+        target.layers = std::move(layers);
+
+        if (settings)
+            target.settings = std::move(*settings);
+    }
+
+    std::vector<SharedJson> load_property_table(json table, PropertyPool& pool)
+    {
+        if (!table.is_array())
+            throw std::runtime_error("Invalid value for 'Property-Table': type must be array");
+
+        std::vector<SharedJson> entries;
+        entries.reserve(table.size());
+        for (auto& value : table)
+            entries.push_back(pool.intern(std::move(value)));
+
+        return entries;
+    }
+
+    const SharedJson& property_table_entry(const std::vector<SharedJson>& table, const int64_t index)
+    {
+        if (index < 0 || static_cast<size_t>(index) >= table.size())
+            throw std::runtime_error("Invalid other-properties-ref: " + std::to_string(index) + " is not in the Property-Table");
+
+        return table[static_cast<size_t>(index)];
+    }
+
+    //////////////////////////////////////////////////////
+    // ProjectSaxHandler
+    //////////////////////////////////////////////////////
+
+    ProjectSaxHandler::ProjectSaxHandler(ProjectSections& sections) : m_sections(sections) { }
+
+    template<typename Forward>
+    bool ProjectSaxHandler::begin_capture(Forward&& forward)
+    {
+        m_dom.reset();
+        m_resume = m_state;
+        m_state = State::Capture;
+        return forward_capture(std::forward<Forward>(forward));
+    }
+
+    template<typename Forward>
+    bool ProjectSaxHandler::forward_capture(Forward&& forward)
+    {
+        forward();
+        if (m_dom.complete())
+            finish_capture();
+
+        return true;
+    }
+
+    void ProjectSaxHandler::finish_capture()
+    {
+        m_state = m_resume;
+
+        if (m_captureField != nullptr)
+        {
+            *m_captureField = std::move(m_dom.result());
+            m_captureField = nullptr;
+            return;
+        }
+
+        json& value = m_dom.result();
+        switch (m_section)
+        {
+            case Section::Project:   m_sections.project = std::move(value); break;
+            case Section::Airport:   m_sections.airport = std::move(value); break;
+            case Section::Settings:  m_sections.settings = std::move(value); break;
+            case Section::PropertyTable: m_sections.propertyTable = std::move(value); break;
+            case Section::Libraries: apply_dom_section(m_sections.libraries, value); break;
+            case Section::Assets:    apply_dom_section(m_sections.assets, value); break;
+            case Section::Layers:    apply_dom_section(m_sections.layers, value); break;
+            case Section::None:      break;
+        }
+    }
+
+    void ProjectSaxHandler::begin_skip()
+    {
+        m_resume = m_state;
+        m_state = State::Skip;
+        m_skipDepth = 1;
+    }
+
+    bool ProjectSaxHandler::is_streamed_section() const
+    {
+        return m_section == Section::Libraries || m_section == Section::Assets || m_section == Section::Layers;
+    }
+
+    void ProjectSaxHandler::begin_section_array()
+    {
+        switch (m_section)
+        {
+            case Section::Libraries: m_sections.libraries.clear(); break;
+            case Section::Assets:    m_sections.assets.clear(); break;
+            case Section::Layers:    m_sections.layers.clear(); break;
+            default:                 break;
+        }
+
+        m_state = State::SectionArray;
+    }
+
+    void ProjectSaxHandler::begin_element()
+    {
+        switch (m_section)
+        {
+            case Section::Libraries: m_sections.libraries.emplace_back(); break;
+            case Section::Assets:    m_sections.assets.emplace_back(); break;
+            case Section::Layers:    m_sections.layers.emplace_back(); break;
+            default:                 break;
+        }
+
+        m_properties = json();
+        m_propertyRef.reset();
+        m_state = State::Element;
+    }
+
+    void ProjectSaxHandler::finish_element()
+    {
+        m_state = State::SectionArray;
+        if (m_section != Section::Assets)
+            return;
+
+        if (m_propertyRef)
+            m_sections.propertyRefs.push_back({m_sections.assets.size() - 1, *m_propertyRef});
+        else if (!m_properties.is_null())
+            m_sections.assets.back().otherProperties = m_sections.properties.intern(std::move(m_properties));
+    }
+
+    void ProjectSaxHandler::bind_field(const std::string_view key)
+    {
+        m_field = std::monostate{};
+        m_fieldName = "";
+
+        const auto bind = [this, key](const char* name, auto* member)
+        {
+            if (key != name)
+                return false;
+
+            m_field = member;
+            m_fieldName = name;
+            return true;
+        };
+
+        switch (m_section)
+        {
+            case Section::Libraries:
+            {
+                auto& lib = m_sections.libraries.back();
+                bind("Library", &lib.name) || bind("local-path", &lib.localPath) ||
+                    bind("entry-count", &lib.entryCount) || bind("uuid", &lib.uuid) ||
+                    bind("short-id", &lib.shortId) || bind("version", &lib.version);
+                break;
+            }
+            case Section::Assets:
+            {
+                auto& asset = m_sections.assets.back();
+                bind("id", &asset.id) || bind("unique-id", &asset.uniqueId) ||
+                    bind("latitude", &asset.latitude) || bind("longitude", &asset.longitude) ||
+                    bind("altitude", &asset.altitude) || bind("heading", &asset.heading) ||
+                    bind("associated-library", &asset.associatedLibrary) || bind("layer-id", &asset.layerId) ||
+                    bind("group-id", &asset.groupId) || bind("locked", &asset.locked) ||
+                    bind("hidden", &asset.hidden) || bind("selected", &asset.selected) ||
+                    bind("other-properties", &m_properties) || bind("other-properties-ref", &m_propertyRef);
+                break;
+            }
+            case Section::Layers:
+            {
+                auto& layer = m_sections.layers.back();
+                bind("layer-id", &layer.layerId) || bind("name", &layer.name) ||
+                    bind("description", &layer.description) || bind("locked", &layer.locked) ||
+                    bind("hidden", &layer.hidden) || bind("opacity", &layer.opacity) ||
+                    bind("z-order", &layer.zOrder) || bind("asset-ids", &layer.assetIds) ||
+                    bind("layer-properties", &layer.layerProperties);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    InternedString ProjectSaxHandler::intern(const std::string_view text)
+    {
+        if (const auto it = m_interned.find(text); it != m_interned.end())
+            return it->second;
+
+        InternedString pooled(text);
+        m_interned.emplace(pooled.view(), pooled);
+        return pooled;
+    }
+
+    void ProjectSaxHandler::type_mismatch() const
+    {
+        const char* expected = "string";
+        if (std::holds_alternative<double*>(m_field) || std::holds_alternative<int*>(m_field) || std::holds_alternative<std::optional<int64_t>*>(m_field))
+            expected = "number";
+        else if (std::holds_alternative<bool*>(m_field))
+            expected = "boolean";
+        else if (std::holds_alternative<std::vector<std::string>*>(m_field))
+            expected = "array";
+
+        throw std::runtime_error(std::string("Invalid value for '") + m_fieldName + "': type must be " + expected);
+    }
+
+    void ProjectSaxHandler::element_not_object() const
+    {
+        throw std::runtime_error("Invalid project section entry: type must be object");
+    }
+
+    template<typename Number>
+    bool ProjectSaxHandler::element_number(const Number val)
+    {
+        if (auto* d = std::get_if<double*>(&m_field))
+            **d = static_cast<double>(val);
+        else if (auto* i = std::get_if<int*>(&m_field))
+            **i = static_cast<int>(val);
+        else if (auto* r = std::get_if<std::optional<int64_t>*>(&m_field))
+            **r = static_cast<int64_t>(val); // Converted like json::get<int64_t> in the DOM path
+        else if (auto* j = std::get_if<json*>(&m_field))
+            **j = val;
+        else if (!std::holds_alternative<std::monostate>(m_field))
+            type_mismatch();
+
+        return true;
+    }
+
+    bool ProjectSaxHandler::null()
+    {
+        switch (m_state)
+        {
+            case State::Capture:      return forward_capture([this] { m_dom.null(); });
+            case State::TopLevel:     return m_section == Section::None || begin_capture([this] { m_dom.null(); });
+            case State::SectionArray: element_not_object();
+            case State::StringArray:  type_mismatch();
+            case State::Element:
+                if (auto* j = std::get_if<json*>(&m_field))
+                    **j = nullptr;
+                else if (!std::holds_alternative<std::monostate>(m_field))
+                    type_mismatch();
+                return true;
+            case State::Root:         m_state = State::Done; return true;
+            default:                  return true;
+        }
+    }
+
+    bool ProjectSaxHandler::boolean(const bool val)
+    {
+        switch (m_state)
+        {
+            case State::Capture:      return forward_capture([this, val] { m_dom.boolean(val); });
+            case State::TopLevel:     return m_section == Section::None || begin_capture([this, val] { m_dom.boolean(val); });
+            case State::SectionArray: element_not_object();
+            case State::StringArray:  type_mismatch();
+            case State::Element:
+                if (auto* b = std::get_if<bool*>(&m_field))
+                    **b = val;
+                else
+                    element_number(val ? 1 : 0);
+                return true;
+            case State::Root:         m_state = State::Done; return true;
+            default:                  return true;
+        }
+    }
+
+    bool ProjectSaxHandler::number_integer(const json::number_integer_t val)
+    {
+        switch (m_state)
+        {
+            case State::Capture:      return forward_capture([this, val] { m_dom.number_integer(val); });
+            case State::TopLevel:     return m_section == Section::None || begin_capture([this, val] { m_dom.number_integer(val); });
+            case State::SectionArray: element_not_object();
+            case State::StringArray:  type_mismatch();
+            case State::Element:      return element_number(val);
+            case State::Root:         m_state = State::Done; return true;
+            default:                  return true;
+        }
+    }
+
+    bool ProjectSaxHandler::number_unsigned(const json::number_unsigned_t val)
+    {
+        switch (m_state)
+        {
+            case State::Capture:      return forward_capture([this, val] { m_dom.number_unsigned(val); });
+            case State::TopLevel:     return m_section == Section::None || begin_capture([this, val] { m_dom.number_unsigned(val); });
+            case State::SectionArray: element_not_object();
+            case State::StringArray:  type_mismatch();
+            case State::Element:      return element_number(val);
+            case State::Root:         m_state = State::Done; return true;
+            default:                  return true;
+        }
+    }
+
+    bool ProjectSaxHandler::number_float(const json::number_float_t val, const json::string_t& s)
+    {
+        switch (m_state)
+        {
+            case State::Capture:      return forward_capture([this, val, &s] { m_dom.number_float(val, s); });
+            case State::TopLevel:     return m_section == Section::None || begin_capture([this, val, &s] { m_dom.number_float(val, s); });
+            case State::SectionArray: element_not_object();
+            case State::StringArray:  type_mismatch();
+            case State::Element:      return element_number(val);
+            case State::Root:         m_state = State::Done; return true;
+            default:                  return true;
+        }
+    }
+
+    bool ProjectSaxHandler::string(json::string_t& val)
+    {
+        switch (m_state)
+        {
+            case State::Capture:      return forward_capture([this, &val] { m_dom.string(val); });
+            case State::TopLevel:     return m_section == Section::None || begin_capture([this, &val] { m_dom.string(val); });
+            case State::SectionArray: element_not_object();
+            case State::StringArray:
+                std::get<std::vector<std::string>*>(m_field)->push_back(std::move(val));
+                return true;
+            case State::Element:
+                if (auto* s = std::get_if<std::string*>(&m_field))
+                    **s = std::move(val);
+                else if (auto* interned = std::get_if<InternedString*>(&m_field))
+                    **interned = intern(val);
+                else if (auto* uniqueId = std::get_if<UniqueId*>(&m_field))
+                    **uniqueId = UniqueId(val);
+                else if (auto* j = std::get_if<json*>(&m_field))
+                    **j = std::move(val);
+                else if (!std::holds_alternative<std::monostate>(m_field))
+                    type_mismatch();
+                return true;
+            case State::Root:         m_state = State::Done; return true;
+            default:                  return true;
+        }
+    }
+
+    bool ProjectSaxHandler::binary(json::binary_t&)
+    {
+        // JSON text never produces binary values
+        return true;
+    }
+
+    bool ProjectSaxHandler::start_object(const std::size_t elements)
+    {
+        switch (m_state)
+        {
+            case State::Capture:
+                return forward_capture([this, elements] { m_dom.start_object(elements); });
+            case State::Skip:
+                ++m_skipDepth;
+                return true;
+            case State::Root:
+                m_state = State::TopLevel;
+                return true;
+            case State::TopLevel:
+                if (m_section == Section::None)
+                {
+                    begin_skip();
+                    return true;
+                }
+                return begin_capture([this, elements] { m_dom.start_object(elements); });
+            case State::SectionArray:
+                begin_element();
+                return true;
+            case State::Element:
+                if (auto* j = std::get_if<json*>(&m_field))
+                {
+                    m_captureField = *j;
+                    return begin_capture([this, elements] { m_dom.start_object(elements); });
+                }
+                if (!std::holds_alternative<std::monostate>(m_field))
+                    type_mismatch();
+                begin_skip();
+                return true;
+            case State::StringArray:
+                type_mismatch();
+            default:
+                return true;
+        }
+    }
+
+    bool ProjectSaxHandler::key(json::string_t& val)
+    {
+        switch (m_state)
+        {
+            case State::Capture:
+                return forward_capture([this, &val] { m_dom.key(val); });
+            case State::TopLevel:
+                if (val == "Project")
+                    m_section = Section::Project;
+                else if (val == "Airport")
+                    m_section = Section::Airport;
+                else if (val == "Libraries")
+                    m_section = Section::Libraries;
+                else if (val == "Assets")
+                    m_section = Section::Assets;
+                else if (val == "Layers")
+                    m_section = Section::Layers;
+                else if (val == "Settings")
+                    m_section = Section::Settings;
+                else if (val == "Property-Table")
+                    m_section = Section::PropertyTable;
+                else
+                    m_section = Section::None;
+                return true;
+            case State::Element:
+                bind_field(val);
+                return true;
+            default:
+                return true;
+        }
+    }
+
+    bool ProjectSaxHandler::end_object()
+    {
+        switch (m_state)
+        {
+            case State::Capture:
+                return forward_capture([this] { m_dom.end_object(); });
+            case State::Skip:
+                if (--m_skipDepth == 0)
+                    m_state = m_resume;
+                return true;
+            case State::TopLevel:
+                m_state = State::Done;
+                return true;
+            case State::Element:
+                finish_element();
+                return true;
+            default:
+                return true;
+        }
+    }
+
+    bool ProjectSaxHandler::start_array(const std::size_t elements)
+    {
+        switch (m_state)
+        {
+            case State::Capture:
+                return forward_capture([this, elements] { m_dom.start_array(elements); });
+            case State::Skip:
+                ++m_skipDepth;
+                return true;
+            case State::Root:
+                m_state = State::Done;
+                begin_skip();
+                return true;
+            case State::TopLevel:
+                if (is_streamed_section())
+                {
+                    begin_section_array();
+                    return true;
+                }
+                if (m_section == Section::None)
+                {
+                    begin_skip();
+                    return true;
+                }
+                return begin_capture([this, elements] { m_dom.start_array(elements); });
+            case State::SectionArray:
+                element_not_object();
+            case State::Element:
+                if (auto* ids = std::get_if<std::vector<std::string>*>(&m_field))
+                {
+                    (*ids)->clear();
+                    m_state = State::StringArray;
+                    return true;
+                }
+                if (auto* j = std::get_if<json*>(&m_field))
+                {
+                    m_captureField = *j;
+                    return begin_capture([this, elements] { m_dom.start_array(elements); });
+                }
+                if (!std::holds_alternative<std::monostate>(m_field))
+                    type_mismatch();
+                begin_skip();
+                return true;
+            case State::StringArray:
+                type_mismatch();
+            default:
+                return true;
+        }
+    }
+
+    bool ProjectSaxHandler::end_array()
+    {
+        switch (m_state)
+        {
+            case State::Capture:
+                return forward_capture([this] { m_dom.end_array(); });
+            case State::Skip:
+                if (--m_skipDepth == 0)
+                    m_state = m_resume;
+                return true;
+            case State::SectionArray:
+                m_state = State::TopLevel;
+                return true;
+            case State::StringArray:
+                m_state = State::Element;
+                return true;
+            default:
+                return true;
+        }
+    }
+
+    bool ProjectSaxHandler::parse_error(std::size_t, const std::string&, const json::exception& ex)
+    {
+        rethrow_parse_error(ex);
+    }
+
+    //////////////////////////////////////////////////////
+
+    void parse_project_section(const std::string& key, const std::string_view text, ProjectSections& sections)
+    {
+        // Replay the enclosing object around the section so the handler sees a normal document
+        ProjectSaxHandler handler(sections);
+        std::string sectionKey = key;
+        handler.start_object(static_cast<std::size_t>(-1));
+        handler.key(sectionKey);
+        json::sax_parse(text.begin(), text.end(), &handler, json::input_format_t::json, true);
+        handler.end_object();
+    }
+
+} // namespace edx::detail
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,219 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXJsonSax.h
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+#include <edX/config/edXConfig.h>
+#include <edX/include/edXProjectFile.h>
+#include <edX/include/edXSharedJson.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx::detail
+{
+    /**
+     * @brief SAX consumer that assembles a json value
+     *
+     * Used to materialize the small or free-form parts of a document (project
+     * metadata, settings, property blobs) while the surrounding structure is
+     * streamed. The builder reports completion once its root value closes.
+     */
+    class JsonDomBuilder
+    {
+    public:
+        void reset();
+        [[nodiscard]] bool complete() const { return m_complete; }
+        [[nodiscard]] json& result() { return m_root; }
+
+        // SAX interface
+        bool null();
+        bool boolean(bool val);
+        bool number_integer(json::number_integer_t val);
+        bool number_unsigned(json::number_unsigned_t val);
+        bool number_float(json::number_float_t val, const json::string_t& s);
+        bool string(json::string_t& val);
+        bool binary(json::binary_t& val);
+        bool start_object(std::size_t elements);
+        bool key(json::string_t& val);
+        bool end_object();
+        bool start_array(std::size_t elements);
+        bool end_array();
+        bool parse_error(std::size_t position, const std::string& lastToken, const json::exception& ex);
+
+    private:
+        template<typename Value>
+        json* insert(Value&& val);
+
+        json m_root;
+        std::vector<json*> m_stack;
+        json* m_keySlot = nullptr;
+        bool m_complete = false;
+    };
+
+    /**
+     * @brief Project sections collected by ProjectSaxHandler
+     *
+     * Kept apart from the target project so a parse error halfway through a
+     * file leaves the caller's project untouched, exactly like the DOM path.
+     */
+    struct ProjectSections
+    {
+        // An asset whose other-properties live in the Property-Table
+        struct PropertyRef
+        {
+            size_t asset;
+            int64_t index;
+        };
+
+        std::optional<json> project;
+        std::optional<json> airport;
+        std::optional<json> settings;
+        std::optional<json> propertyTable;
+        std::vector<LibraryReference> libraries;
+        std::vector<SceneAsset> assets;
+        std::vector<SceneLayer> layers;
+
+        // Inline blobs are interned as they are parsed; refs wait for the table,
+        // which may come after the Assets section
+        PropertyPool properties;
+        std::vector<PropertyRef> propertyRefs;
+
+        // Point each referencing asset at its table entry; throws on a missing
+        // table or a bad index. Ref positions index into target.
+        void resolve_property_refs(std::span<SceneAsset> target);
+
+        // Apply to a project in the same order as EdxProject::from_json
+        void commit(EdxProject& target);
+    };
+
+    // Canonical handles for the entries of a "Property-Table" array
+    std::vector<SharedJson> load_property_table(json table, PropertyPool& pool);
+
+    // Table entry named by an "other-properties-ref" value; throws if out of range
+    const SharedJson& property_table_entry(const std::vector<SharedJson>& table, int64_t index);
+
+    /**
+     * @brief SAX consumer that builds project sections without a document DOM
+     *
+     * Libraries, assets and layers are written straight into their vectors as
+     * the tokens arrive. Project, airport and settings sections are small and
+     * are assembled with JsonDomBuilder, then handed to the regular from_json.
+     * Type mismatches are rejected wherever the DOM path would reject them.
+     */
+    class ProjectSaxHandler
+    {
+    public:
+        explicit ProjectSaxHandler(ProjectSections& sections);
+
+        // SAX interface
+        bool null();
+        bool boolean(bool val);
+        bool number_integer(json::number_integer_t val);
+        bool number_unsigned(json::number_unsigned_t val);
+        bool number_float(json::number_float_t val, const json::string_t& s);
+        bool string(json::string_t& val);
+        bool binary(json::binary_t& val);
+        bool start_object(std::size_t elements);
+        bool key(json::string_t& val);
+        bool end_object();
+        bool start_array(std::size_t elements);
+        bool end_array();
+        bool parse_error(std::size_t position, const std::string& lastToken, const json::exception& ex);
+
+    private:
+        enum class Section : uint8_t { None, Project, Airport, Libraries, Assets, Layers, Settings, PropertyTable };
+        enum class State : uint8_t { Root, TopLevel, SectionArray, Element, StringArray, Capture, Skip, Done };
+
+        // Destination of the value that follows an element key; monostate skips the value
+        using FieldRef = std::variant<std::monostate, std::string*, InternedString*, UniqueId*, double*, int*, std::optional<int64_t>*, bool*, json*,
+                                      std::vector<std::string>*>;
+
+        template<typename Forward>
+        bool begin_capture(Forward&& forward);
+        template<typename Forward>
+        bool forward_capture(Forward&& forward);
+        void finish_capture();
+        void begin_skip();
+
+        template<typename Number>
+        bool element_number(Number val);
+        [[nodiscard]] bool is_streamed_section() const;
+        void begin_section_array();
+        void begin_element();
+        void finish_element();
+        void bind_field(std::string_view key);
+        InternedString intern(std::string_view text);
+        [[noreturn]] void type_mismatch() const;
+        [[noreturn]] void element_not_object() const;
+
+        ProjectSections& m_sections;
+        JsonDomBuilder m_dom;
+        State m_state = State::Root;
+        State m_resume = State::Root;
+        Section m_section = Section::None;
+        FieldRef m_field;
+        const char* m_fieldName = "";
+        json* m_captureField = nullptr;
+        size_t m_skipDepth = 0;
+
+        // Property fields of the current asset, parsed here so the blob can be interned
+        json m_properties;
+        std::optional<int64_t> m_propertyRef;
+
+        // Reference strings seen in this load, keyed by their pooled text, so
+        // repeats skip the shared pool's lock
+        std::unordered_map<std::string_view, InternedString> m_interned;
+    };
+
+    /**
+     * @brief Parse one top-level section of a project document on its own
+     *
+     * @param key Section name, e.g. "Assets"
+     * @param text Raw text of the section's value, as returned by JsonSkimmer::skip_value
+     * @param sections Receives the parsed section
+     */
+    void parse_project_section(const std::string& key, std::string_view text, ProjectSections& sections);
+
+    /**
+     * @brief Parse a project document with the Assets and Layers arrays split across threads
+     *
+     * One skim pass finds the element boundaries; contiguous runs of elements
+     * are then parsed concurrently and concatenated in their original order.
+     *
+     * @return False (leaving target untouched) if the document is not laid out
+     *         as an object of sections and should go through the serial parser
+     */
+    bool parse_project_parallel(std::string_view text, unsigned int threadCount, EdxProject& target);
+
+} // namespace edx::detail
+
+/// ----------------------------------------------------------------------------
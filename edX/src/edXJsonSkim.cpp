@@ -0,0 +1,219 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXJsonSkim.cpp
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#include <cstring>
+#include <stdexcept>
+#include <edX/src/edXJsonSkim.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx::detail
+{
+    JsonSkimmer::JsonSkimmer(const std::string_view text) : m_text(text)
+    {
+        // Skip a UTF-8 byte order mark, as the nlohmann lexer does
+        if (m_text.starts_with("\xEF\xBB\xBF"))
+            m_pos = 3;
+    }
+
+    bool JsonSkimmer::begin_object()
+    {
+        skip_whitespace();
+        if (m_pos >= m_text.size() || m_text[m_pos] != '{')
+            return false;
+
+        ++m_pos;
+        m_firstMember.push_back(true);
+        return true;
+    }
+
+    bool JsonSkimmer::next_key(std::string& key)
+    {
+        if (!next_member('}'))
+            return false;
+
+        if (m_pos >= m_text.size() || m_text[m_pos] != '"')
+            fail("expected object key");
+
+        const std::string_view raw = skip_string();
+
+        // Keys with escapes are rare; let the real parser decode them
+        if (raw.find('\\') != std::string_view::npos)
+            key = json::parse(raw).get<std::string>();
+        else
+            key.assign(raw.substr(1, raw.size() - 2));
+
+        skip_whitespace();
+        if (m_pos >= m_text.size() || m_text[m_pos] != ':')
+            fail("expected ':'");
+
+        ++m_pos;
+        return true;
+    }
+
+    bool JsonSkimmer::begin_array()
+    {
+        skip_whitespace();
+        if (m_pos >= m_text.size() || m_text[m_pos] != '[')
+            return false;
+
+        ++m_pos;
+        m_firstMember.push_back(true);
+        return true;
+    }
+
+    bool JsonSkimmer::next_element()
+    {
+        if (!next_member(']'))
+            return false;
+
+        skip_whitespace();
+        return true;
+    }
+
+    bool JsonSkimmer::next_member(const char closing)
+    {
+        if (m_firstMember.empty())
+            fail("no open container");
+
+        skip_whitespace();
+        if (m_pos >= m_text.size())
+            fail("unterminated container");
+
+        if (m_text[m_pos] == closing)
+        {
+            ++m_pos;
+            m_firstMember.pop_back();
+            return false;
+        }
+
+        if (!m_firstMember.back())
+        {
+            if (m_text[m_pos] != ',')
+                fail("expected ','");
+
+            ++m_pos;
+            skip_whitespace();
+        }
+
+        m_firstMember.back() = false;
+        return true;
+    }
+
+    std::string_view JsonSkimmer::skip_value()
+    {
+        skip_whitespace();
+        if (m_pos >= m_text.size())
+            fail("expected value");
+
+        const size_t start = m_pos;
+        const char first = m_text[m_pos];
+
+        if (first == '"')
+            return skip_string();
+
+        if (first == '{' || first == '[')
+        {
+            size_t depth = 0;
+            while (m_pos < m_text.size())
+            {
+                switch (m_text[m_pos])
+                {
+                    case '"':
+                        skip_string();
+                        continue;
+                    case '{':
+                    case '[':
+                        ++depth;
+                        break;
+                    case '}':
+                    case ']':
+                        if (--depth == 0)
+                        {
+                            ++m_pos;
+                            return m_text.substr(start, m_pos - start);
+                        }
+                        break;
+                    default:
+                        break;
+                }
+                ++m_pos;
+            }
+
+            fail("unterminated container");
+        }
+
+        // Number or literal: runs until the next delimiter
+        while (m_pos < m_text.size() && !std::strchr(",}] \t\r\n", m_text[m_pos]))
+            ++m_pos;
+
+        if (m_pos == start)
+            fail("expected value");
+
+        return m_text.substr(start, m_pos - start);
+    }
+
+    void JsonSkimmer::skip_whitespace()
+    {
+        while (m_pos < m_text.size())
+        {
+            const char c = m_text[m_pos];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+                break;
+
+            ++m_pos;
+        }
+    }
+
+    std::string_view JsonSkimmer::skip_string()
+    {
+        const size_t start = m_pos++;
+        while (true)
+        {
+            const void* quote = std::memchr(m_text.data() + m_pos, '"', m_text.size() - m_pos);
+            if (quote == nullptr)
+                fail("unterminated string");
+
+            const size_t quotePos = static_cast<const char*>(quote) - m_text.data();
+
+            // The quote is escaped if preceded by an odd number of backslashes
+            size_t backslashes = 0;
+            while (quotePos - backslashes > start + 1 && m_text[quotePos - backslashes - 1] == '\\')
+                ++backslashes;
+
+            m_pos = quotePos + 1;
+            if (backslashes % 2 == 0)
+                return m_text.substr(start, m_pos - start);
+        }
+    }
+
+    void JsonSkimmer::fail(const char* what) const
+    {
+        throw std::runtime_error("Malformed JSON at offset " + std::to_string(m_pos) + ": " + what);
+    }
+
+} // namespace edx::detail
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,84 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXJsonSkim.h
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <edX/config/edXConfig.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx::detail
+{
+    /**
+     * @brief Structural scanner for JSON objects and arrays
+     *
+     * Walks the keys of an object (or the elements of an array) and skips over
+     * values by matching brackets and string quotes only; nothing is decoded.
+     * Used to locate top-level sections (e.g. "Project" or "Assets") and the
+     * element boundaries inside them without parsing the rest of the document.
+     * Malformed structure throws std::runtime_error; the contents of skipped
+     * values are not validated.
+     */
+    class JsonSkimmer
+    {
+    public:
+        explicit JsonSkimmer(std::string_view text);
+
+        // Consume the opening brace of an object; false if the next value is not an object
+        bool begin_object();
+
+        // Advance to the next key of the current object; false once its closing brace is consumed
+        bool next_key(std::string& key);
+
+        // Consume the opening bracket of an array; false if the next value is not an array
+        bool begin_array();
+
+        // Advance to the next element of the current array; false once its closing bracket is consumed
+        bool next_element();
+
+        // Skip the value following a key and return its raw text
+        std::string_view skip_value();
+
+        // Byte offset of the cursor from the start of the text
+        [[nodiscard]] size_t offset() const { return m_pos; }
+
+    private:
+        void skip_whitespace();
+        std::string_view skip_string();
+        bool next_member(char closing);
+        [[noreturn]] void fail(const char* what) const;
+
+        std::string_view m_text;
+        size_t m_pos = 0;
+
+        // One entry per open container: true until its first member is reached
+        std::vector<bool> m_firstMember;
+    };
+
+} // namespace edx::detail
+
+/// ----------------------------------------------------------------------------
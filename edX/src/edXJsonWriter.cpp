@@ -0,0 +1,216 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXJsonWriter.cpp
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <edX/src/edXJsonWriter.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx::detail
+{
+    namespace
+    {
+        constexpr unsigned int INDENT_STEP = 4;
+
+        // True when the string can be written between quotes without escaping or UTF-8 validation
+        bool is_plain_ascii(const std::string_view val)
+        {
+            return std::ranges::all_of(val, [](const char c)
+            {
+                const auto byte = static_cast<unsigned char>(c);
+                return byte >= 0x20 && byte < 0x80 && c != '"' && c != '\\';
+            });
+        }
+    }
+
+    JsonWriter::JsonWriter(OutputSink& sink, const bool prettyPrint, const size_t bufferSize)
+        : m_sink(sink), m_bufferSize(bufferSize), m_prettyPrint(prettyPrint),
+          m_serializer(std::make_shared<BufferAdapter>(*this), ' ')
+    {
+        m_buffer.reserve(m_bufferSize);
+    }
+
+    void JsonWriter::begin_object()
+    {
+        before_value();
+        put('{');
+        m_frames.emplace_back();
+    }
+
+    void JsonWriter::end_object()
+    {
+        const Frame frame = m_frames.back();
+        m_frames.pop_back();
+
+        if (m_prettyPrint && !frame.empty)
+            newline_indent(m_frames.size());
+
+        put('}');
+    }
+
+    void JsonWriter::begin_array()
+    {
+        before_value();
+        put('[');
+        m_frames.emplace_back();
+    }
+
+    void JsonWriter::end_array()
+    {
+        const Frame frame = m_frames.back();
+        m_frames.pop_back();
+
+        if (m_prettyPrint && !frame.empty)
+            newline_indent(m_frames.size());
+
+        put(']');
+    }
+
+    void JsonWriter::key(const std::string_view name)
+    {
+        before_value();
+
+        put('"');
+        write(name.data(), name.size());
+        put('"');
+        put(':');
+        if (m_prettyPrint)
+            put(' ');
+
+        m_afterKey = true;
+    }
+
+    void JsonWriter::value(const std::string_view val)
+    {
+        before_value();
+
+        if (is_plain_ascii(val))
+        {
+            put('"');
+            write(val.data(), val.size());
+            put('"');
+            return;
+        }
+
+        m_serializer.dump(json(val), false, false, 0);
+    }
+
+    void JsonWriter::value(const double val)
+    {
+        before_value();
+        m_serializer.dump(json(val), false, false, 0);
+    }
+
+    void JsonWriter::value(const int val)
+    {
+        before_value();
+        m_serializer.dump(json(val), false, false, 0);
+    }
+
+    void JsonWriter::value(const bool val)
+    {
+        before_value();
+        if (val)
+            write("true", 4);
+        else
+            write("false", 5);
+    }
+
+    void JsonWriter::value(const json& val)
+    {
+        before_value();
+
+        const auto currentIndent = static_cast<unsigned int>(m_frames.size()) * INDENT_STEP;
+        m_serializer.dump(val, m_prettyPrint, false, INDENT_STEP, m_prettyPrint ? currentIndent : 0);
+    }
+
+    void JsonWriter::flush()
+    {
+        if (m_buffer.empty())
+            return;
+
+        m_sink.write(m_buffer.data(), m_buffer.size());
+        m_buffer.clear();
+    }
+
+    void JsonWriter::before_value()
+    {
+        if (m_afterKey)
+        {
+            m_afterKey = false;
+            return;
+        }
+
+        if (m_frames.empty())
+            return;
+
+        Frame& frame = m_frames.back();
+        if (!frame.empty)
+            put(',');
+
+        frame.empty = false;
+        if (m_prettyPrint)
+            newline_indent(m_frames.size());
+    }
+
+    void JsonWriter::newline_indent(const size_t depth)
+    {
+        static constexpr std::string_view spaces = "                                                                ";
+
+        put('\n');
+        for (size_t remaining = depth * INDENT_STEP; remaining > 0;)
+        {
+            const size_t count = std::min(remaining, spaces.size());
+            write(spaces.data(), count);
+            remaining -= count;
+        }
+    }
+
+    void JsonWriter::write(const char* data, const size_t size)
+    {
+        if (m_buffer.size() + size > m_bufferSize)
+        {
+            flush();
+            if (size >= m_bufferSize)
+            {
+                m_sink.write(data, size);
+                return;
+            }
+        }
+
+        m_buffer.append(data, size);
+    }
+
+    void JsonWriter::put(const char c)
+    {
+        if (m_buffer.size() >= m_bufferSize)
+            flush();
+
+        m_buffer.push_back(c);
+    }
+
+} // namespace edx::detail
+
+/// ----------------------------------------------------------------------------
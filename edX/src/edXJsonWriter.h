@@ -0,0 +1,117 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXJsonWriter.h
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <edX/config/edXConfig.h>
+#include <edX/include/edXFileIO.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx::detail
+{
+    /**
+     * @brief Incremental JSON text writer
+     *
+     * Emits tokens straight into a buffered OutputSink without building a json
+     * tree. The output is byte-identical to json::dump(4) (or json::dump() in
+     * compact mode) provided the caller emits object keys in sorted order, the
+     * order nlohmann's std::map-backed objects use.
+     */
+    class JsonWriter
+    {
+    public:
+        JsonWriter(OutputSink& sink, bool prettyPrint, size_t bufferSize = 64 * 1024);
+
+        JsonWriter(const JsonWriter&) = delete;
+        JsonWriter& operator=(const JsonWriter&) = delete;
+
+        void begin_object();
+        void end_object();
+        void begin_array();
+        void end_array();
+
+        // Object keys are written verbatim and must not need escaping
+        void key(std::string_view name);
+
+        void value(std::string_view val);
+        void value(const std::string& val) { value(std::string_view(val)); }
+        void value(const char* val) { value(std::string_view(val)); }
+        void value(double val);
+        void value(int val);
+        void value(bool val);
+        void value(const json& val);
+
+        template<typename T>
+        void member(const std::string_view name, const T& val)
+        {
+            key(name);
+            value(val);
+        }
+
+        // Push buffered output to the sink; must be called once writing is done
+        void flush();
+
+    private:
+        // Routes nlohmann serializer output into this writer's buffer
+        class BufferAdapter final : public nlohmann::detail::output_adapter_protocol<char>
+        {
+        public:
+            explicit BufferAdapter(JsonWriter& writer) : m_writer(writer) { }
+
+            void write_character(char c) override { m_writer.put(c); }
+            void write_characters(const char* s, std::size_t length) override { m_writer.write(s, length); }
+
+        private:
+            JsonWriter& m_writer;
+        };
+
+        void before_value();
+        void newline_indent(size_t depth);
+        void write(const char* data, size_t size);
+        void put(char c);
+
+        struct Frame
+        {
+            bool empty = true;
+        };
+
+        OutputSink& m_sink;
+        std::string m_buffer;
+        size_t m_bufferSize;
+        std::vector<Frame> m_frames;
+        bool m_prettyPrint;
+        bool m_afterKey = false;
+
+        // Numbers, strings that need escaping and embedded json values go through
+        // nlohmann's own serializer so their text matches json::dump exactly
+        nlohmann::detail::serializer<json> m_serializer;
+    };
+
+} // namespace edx::detail
+
+/// ----------------------------------------------------------------------------
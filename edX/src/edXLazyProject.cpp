@@ -0,0 +1,192 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXLazyProject.cpp
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#include <iostream>
+#include <istream>
+#include <edX/include/edXLazyProject.h>
+#include <edX/src/edXCompression.h>
+#include <edX/src/edXJsonSax.h>
+#include <edX/src/edXJsonSkim.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    bool LazyEdxProject::open(const std::filesystem::path& filePath)
+    {
+        try
+        {
+            if (!std::filesystem::exists(filePath))
+            {
+                std::cerr << "Error: File does not exist: " << filePath << '\n';
+                return false;
+            }
+
+            auto file = MappedFile::open(filePath);
+            const std::string_view text = file->view();
+
+            // Binary and compressed files have no text to index; read them completely
+            if (EdxProject::is_binary_data(text) || detail::is_compressed(text))
+            {
+                EdxProject project;
+                if (detail::is_compressed(text))
+                {
+                    detail::DecompressingStreamBuf buffer(text);
+                    std::istream stream(&buffer);
+                    project.from_json_stream(stream);
+                }
+                else
+                {
+                    project.from_binary_buffer(text);
+                }
+
+                m_project = std::move(project);
+                m_file.reset();
+                m_assetsSpan.reset();
+                m_layersSpan.reset();
+                m_settingsSpan.reset();
+                m_propertyTableSpan.reset();
+                return true;
+            }
+
+            detail::JsonSkimmer skimmer(text);
+            if (!skimmer.begin_object())
+            {
+                std::cerr << "Error: Not a project file: " << filePath << '\n';
+                return false;
+            }
+
+            // Metadata is parsed now; the spans of the bulky sections are only recorded
+            detail::ProjectSections sections;
+            std::optional<SectionSpan> assetsSpan, layersSpan, settingsSpan, propertyTableSpan;
+
+            std::string key;
+            while (skimmer.next_key(key))
+            {
+                const std::string_view value = skimmer.skip_value();
+                const SectionSpan span{static_cast<size_t>(value.data() - text.data()), value.size()};
+
+                if (key == "Assets")
+                    assetsSpan = span;
+                else if (key == "Layers")
+                    layersSpan = span;
+                else if (key == "Settings")
+                    settingsSpan = span;
+                else if (key == "Property-Table")
+                    propertyTableSpan = span;
+                else if (key == "Project" || key == "Airport" || key == "Libraries")
+                    detail::parse_project_section(key, value, sections);
+            }
+
+            EdxProject project;
+            sections.commit(project);
+
+            m_project = std::move(project);
+            m_file = std::move(file);
+            m_assetsSpan = assetsSpan;
+            m_layersSpan = layersSpan;
+            m_settingsSpan = settingsSpan;
+            m_propertyTableSpan = assetsSpan ? propertyTableSpan : std::nullopt;
+            release_file_if_done();
+            return true;
+        }
+        catch (const json::parse_error& e)
+        {
+            std::cerr << "JSON parse error: " << e.what() << '\n';
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Error opening project file: " << e.what() << '\n';
+            return false;
+        }
+    }
+
+    std::vector<SceneAsset>& LazyEdxProject::assets()
+    {
+        load_section("Assets", m_assetsSpan);
+        return m_project.assets;
+    }
+
+    std::vector<SceneLayer>& LazyEdxProject::layers()
+    {
+        load_section("Layers", m_layersSpan);
+        return m_project.layers;
+    }
+
+    json& LazyEdxProject::settings()
+    {
+        load_section("Settings", m_settingsSpan);
+        return m_project.settings;
+    }
+
+    EdxProject LazyEdxProject::take_project()
+    {
+        load_section("Assets", m_assetsSpan);
+        load_section("Layers", m_layersSpan);
+        load_section("Settings", m_settingsSpan);
+        return std::move(m_project);
+    }
+
+    void LazyEdxProject::load_section(const char* key, std::optional<SectionSpan>& span)
+    {
+        if (!span)
+            return;
+
+        detail::ProjectSections sections;
+        detail::parse_project_section(key, m_file->view().substr(span->offset, span->length), sections);
+
+        // Only the parsed section is applied; the others were never populated
+        if (&span == &m_assetsSpan)
+        {
+            // The table is only needed by the assets, so it is read along with them
+            if (m_propertyTableSpan)
+            {
+                detail::parse_project_section("Property-Table", m_file->view().substr(m_propertyTableSpan->offset, m_propertyTableSpan->length), sections);
+                m_propertyTableSpan.reset();
+            }
+
+            sections.resolve_property_refs(sections.assets);
+            m_project.assets = std::move(sections.assets);
+            m_project.invalidate_asset_indexes();
+        }
+        else if (&span == &m_layersSpan)
+            m_project.layers = std::move(sections.layers);
+        else if (sections.settings)
+            m_project.settings = std::move(*sections.settings);
+
+        span.reset();
+        release_file_if_done();
+    }
+
+    void LazyEdxProject::release_file_if_done()
+    {
+        if (!m_assetsSpan && !m_layersSpan && !m_settingsSpan)
+            m_file.reset();
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
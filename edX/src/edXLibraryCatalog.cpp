@@ -0,0 +1,334 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXLibraryCatalog.cpp
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <system_error>
+#include <edX/include/edXLibraryCatalog.h>
+#include <edX/src/edXHash.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    namespace
+    {
+        constexpr int CATALOG_VERSION = 1;
+
+        // Absolute, normalized form used as the catalog key
+        std::filesystem::path catalog_key(const std::filesystem::path& path)
+        {
+            std::error_code error;
+            const std::filesystem::path absolute = std::filesystem::absolute(path, error);
+            return (error ? path : absolute).lexically_normal();
+        }
+
+        std::vector<std::pair<std::string, size_t>> count_values(const std::map<std::string, size_t>& counts)
+        {
+            return {counts.begin(), counts.end()};
+        }
+    }
+
+    //////////////////////////////////////////////////////
+    // Catalog entries
+    //////////////////////////////////////////////////////
+
+    void CatalogObject::to_json(json& j) const
+    {
+        j = json{
+            {"id", id},
+            {"unique-id", uniqueId},
+            {"name", name},
+            {"asset-type", assetType},
+            {"category", category},
+            {"tags", tags}
+        };
+    }
+
+    void CatalogObject::from_json(const json& j)
+    {
+        id = j.at("id").get<std::string>();
+        uniqueId = j.at("unique-id").get<UniqueId>();
+        name = j.at("name").get<std::string>();
+        assetType = j.at("asset-type").get<std::string>();
+        category = j.at("category").get<std::string>();
+        tags = j.at("tags").get<std::vector<std::string>>();
+    }
+
+    CatalogEntry CatalogEntry::summarize(const LibraryFile& library)
+    {
+        CatalogEntry entry;
+        entry.library = library.library;
+        entry.objects.reserve(library.objects.size());
+
+        std::map<std::string, size_t> categories;
+        std::map<std::string, size_t> assetTypes;
+        for (const auto& obj : library.objects)
+        {
+            entry.objects.push_back({obj.id, obj.uniqueId, obj.name, obj.assetType, obj.category, obj.tags});
+            if (!obj.category.empty())
+                ++categories[obj.category];
+
+            if (!obj.assetType.empty())
+                ++assetTypes[obj.assetType];
+        }
+
+        entry.categories = count_values(categories);
+        entry.assetTypes = count_values(assetTypes);
+        return entry;
+    }
+
+    void CatalogEntry::to_json(json& j) const
+    {
+        // Stored as UTF-8 whatever the platform's path encoding
+        const std::u8string pathText = path.generic_u8string();
+
+        json libraryJson;
+        library.to_json(libraryJson);
+
+        json objectsJson = json::array();
+        for (const auto& obj : objects)
+        {
+            json objJson;
+            obj.to_json(objJson);
+            objectsJson.push_back(std::move(objJson));
+        }
+
+        j = json{
+            {"path", std::string(pathText.begin(), pathText.end())},
+            {"file-size", fileSize},
+            {"modified", modified},
+            {"content-hash", contentHash},
+            {"Library", libraryJson},
+            {"Objects", objectsJson},
+            {"categories", categories},
+            {"asset-types", assetTypes}
+        };
+    }
+
+    void CatalogEntry::from_json(const json& j)
+    {
+        const std::string pathText = j.at("path").get<std::string>();
+        path = std::filesystem::path(std::u8string(pathText.begin(), pathText.end()));
+        fileSize = j.at("file-size").get<uint64_t>();
+        modified = j.at("modified").get<int64_t>();
+        contentHash = j.at("content-hash").get<uint64_t>();
+        library.from_json(j.at("Library"));
+
+        objects.clear();
+        for (const auto& objJson : j.at("Objects"))
+        {
+            CatalogObject obj;
+            obj.from_json(objJson);
+            objects.push_back(std::move(obj));
+        }
+
+        categories = j.at("categories").get<std::vector<std::pair<std::string, size_t>>>();
+        assetTypes = j.at("asset-types").get<std::vector<std::pair<std::string, size_t>>>();
+    }
+
+    //////////////////////////////////////////////////////
+    // Catalog file
+    //////////////////////////////////////////////////////
+
+    bool LibraryCatalog::load(const std::filesystem::path& catalogPath)
+    {
+        m_entries.clear();
+        m_dirty = false;
+        m_savedAt = INT64_MIN;
+
+        try
+        {
+            if (!std::filesystem::exists(catalogPath))
+                return false;
+
+            const int64_t savedAt = std::filesystem::last_write_time(catalogPath).time_since_epoch().count();
+            const auto file = MappedFile::open(catalogPath);
+            const json document = json::from_cbor(file->view());
+            if (document.at("version").get<int>() != CATALOG_VERSION)
+                return false;
+
+            for (const auto& entryJson : document.at("Libraries"))
+            {
+                CatalogEntry entry;
+                entry.from_json(entryJson);
+                m_entries.push_back(std::move(entry));
+            }
+
+            std::ranges::sort(m_entries, {}, &CatalogEntry::path);
+            m_savedAt = savedAt;
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Error loading library catalog: " << e.what() << '\n';
+            m_entries.clear();
+            return false;
+        }
+    }
+
+    bool LibraryCatalog::save(const std::filesystem::path& catalogPath, const Durability durability) const
+    {
+        try
+        {
+            json entriesJson = json::array();
+            for (const auto& entry : m_entries)
+            {
+                json entryJson;
+                entry.to_json(entryJson);
+                entriesJson.push_back(std::move(entryJson));
+            }
+
+            const json document = {{"version", CATALOG_VERSION}, {"Libraries", std::move(entriesJson)}};
+            const std::vector<uint8_t> bytes = json::to_cbor(document);
+
+            AtomicFileWriter file(catalogPath, durability);
+            file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+            file.commit();
+
+            m_dirty = false;
+            m_savedAt = std::filesystem::last_write_time(catalogPath).time_since_epoch().count();
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Error saving library catalog: " << e.what() << '\n';
+            return false;
+        }
+    }
+
+    //////////////////////////////////////////////////////
+    // Revalidation
+    //////////////////////////////////////////////////////
+
+    LibraryCatalog::RefreshResult LibraryCatalog::refresh(const std::filesystem::path& directory, const std::string_view extension)
+    {
+        std::vector<std::filesystem::path> files;
+        std::error_code error;
+        for (auto it = std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied, error);
+             !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+        {
+            if (it->is_regular_file(error) && it->path().extension() == extension)
+                files.push_back(it->path());
+        }
+
+        return refresh(std::move(files));
+    }
+
+    LibraryCatalog::RefreshResult LibraryCatalog::refresh(std::vector<std::filesystem::path> files)
+    {
+        for (auto& file : files)
+            file = catalog_key(file);
+
+        std::ranges::sort(files);
+        const auto [first, last] = std::ranges::unique(files);
+        files.erase(first, last);
+
+        RefreshResult result;
+        std::vector<CatalogEntry> entries;
+        entries.reserve(files.size());
+
+        // Both lists are sorted by path, so old entries are matched in one pass
+        auto old = m_entries.begin();
+        for (const auto& file : files)
+        {
+            while (old != m_entries.end() && old->path < file)
+            {
+                ++result.removed;
+                ++old;
+            }
+
+            CatalogEntry* cached = nullptr;
+            if (old != m_entries.end() && old->path == file)
+                cached = &*old++;
+
+            std::error_code error;
+            const uint64_t size = std::filesystem::file_size(file, error);
+            const int64_t modified = error ? 0 : static_cast<int64_t>(std::filesystem::last_write_time(file, error).time_since_epoch().count());
+            if (error)
+            {
+                result.failed.push_back(file);
+                continue;
+            }
+
+            // A file written no earlier than the catalog may have changed
+            // again within the same timestamp, so only older ones are trusted
+            if (cached && cached->fileSize == size && cached->modified == modified && modified < m_savedAt)
+            {
+                ++result.unchanged;
+                entries.push_back(std::move(*cached));
+                continue;
+            }
+
+            try
+            {
+                const auto mapped = MappedFile::open(file);
+                const uint64_t hash = detail::fnv1a(mapped->view());
+                if (cached && cached->fileSize == size && cached->contentHash == hash)
+                {
+                    ++result.touched;
+                    cached->modified = modified;
+                    entries.push_back(std::move(*cached));
+                    continue;
+                }
+
+                LibraryFile library;
+                library.from_file_data(mapped->view());
+
+                CatalogEntry entry = CatalogEntry::summarize(library);
+                entry.path = file;
+                entry.fileSize = size;
+                entry.modified = modified;
+                entry.contentHash = hash;
+                entries.push_back(std::move(entry));
+                ++result.parsed;
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Error cataloguing library " << file << ": " << e.what() << '\n';
+                result.failed.push_back(file);
+            }
+        }
+
+        result.removed += static_cast<size_t>(m_entries.end() - old);
+
+        if (result.touched != 0 || result.parsed != 0 || entries.size() != m_entries.size())
+            m_dirty = true;
+
+        m_entries = std::move(entries);
+        return result;
+    }
+
+    const CatalogEntry* LibraryCatalog::find(const std::filesystem::path& path) const
+    {
+        const std::filesystem::path key = catalog_key(path);
+        const auto it = std::ranges::lower_bound(m_entries, key, {}, &CatalogEntry::path);
+        return it != m_entries.end() && it->path == key ? &*it : nullptr;
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
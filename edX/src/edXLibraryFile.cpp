@@ -24,16 +24,49 @@
 * -------------------------------------------------------
 */
 #include <algorithm>
-#include <fstream>
 #include <iostream>
+#include <istream>
 #include <set>
+#include <unordered_set>
+#include <edX/include/edXFileIO.h>
 #include <edX/include/edXLibraryFile.h>
 #include <edX/include/edXTimeUtils.h>
+#include <edX/src/edXCompression.h>
+#include <edX/src/edXJsonSax.h>
+#include <edX/src/edXJsonWriter.h>
 
 /// ----------------------------------------------------------------------------
 
 namespace edx
 {
+    namespace
+    {
+        // Keys in the sorted order nlohmann uses so the output matches to_json() + dump()
+        void write_library_object(detail::JsonWriter& writer, const LibraryObject& obj)
+        {
+            writer.begin_object();
+            writer.member("asset-type", obj.assetType);
+            writer.member("category", obj.category);
+            writer.member("description", obj.description);
+            writer.member("id", obj.id);
+            writer.member("name", obj.name);
+            writer.member("object-path", obj.objectPath);
+            writer.member("preview-image", obj.previewImage);
+            if (!obj.properties.empty())
+                writer.member("properties", obj.properties.get());
+
+            writer.key("tags");
+            writer.begin_array();
+            for (const auto& tag : obj.tags)
+                writer.value(tag);
+            writer.end_array();
+
+            writer.member("texture-path", obj.texturePath);
+            writer.member("unique-id", obj.uniqueId.str());
+            writer.end_object();
+        }
+    }
+
     // Library JSON serialization
     void Library::to_json(json& j) const
     {
@@ -133,35 +166,81 @@ namespace edx
             library.from_json(j["Library"]);
         }
 
+        // Catalogues repeat a few property sets many times; keep one copy of each
+        PropertyPool properties;
         objects.clear();
+        invalidate_object_indexes();
         if (j.contains("Objects")) {
             for (const auto& objJson : j["Objects"]) {
                 LibraryObject obj;
                 obj.from_json(objJson);
+                obj.properties = properties.intern(obj.properties);
                 objects.push_back(obj);
             }
         }
     }
 
+    void LibraryFile::from_json_buffer(const std::string_view text)
+    {
+        // Non-strict like operator>>: parsing stops after the root value
+        detail::JsonDomBuilder builder;
+        json::sax_parse(text.data(), text.data() + text.size(), &builder, json::input_format_t::json, false);
+        from_json(builder.result());
+    }
+
+    void LibraryFile::from_file_data(const std::string_view data)
+    {
+        if (!detail::is_compressed(data))
+        {
+            from_json_buffer(data);
+            return;
+        }
+
+        detail::DecompressingStreamBuf buffer(data);
+        std::istream stream(&buffer);
+
+        detail::JsonDomBuilder builder;
+        json::sax_parse(stream, &builder, json::input_format_t::json, false);
+        from_json(builder.result());
+    }
+
+    void LibraryFile::write_json(OutputSink& sink, const SaveOptions& options) const
+    {
+        detail::JsonWriter writer(sink, options.prettyPrint);
+
+        json libraryJson;
+        library.to_json(libraryJson);
+
+        writer.begin_object();
+        writer.member("Library", libraryJson);
+
+        writer.key("Objects");
+        writer.begin_array();
+        for (const auto& obj : objects)
+            write_library_object(writer, obj);
+        writer.end_array();
+
+        writer.end_object();
+        writer.flush();
+    }
+
     // File operations
-    bool LibraryFile::save_to_file(const std::filesystem::path& filePath) const
+    bool LibraryFile::save_to_file(const std::filesystem::path& filePath, const SaveOptions& options) const
     {
         try
 		{
-            json j;
-            to_json(j);
-
-            std::ofstream file(filePath);
-            if (!file.is_open())
-			{
-                std::cerr << "Error: Cannot open file for writing: " << filePath << '\n';
-                return false;
+            // Written to a temporary file and renamed into place on success
+            AtomicFileWriter file(filePath, options.durability);
+            detail::write_with_compression(file, options, [&](OutputSink& sink) { write_json(sink, options); });
+            file.commit();
+
+            if (options.searchIndex)
+            {
+                AtomicFileWriter index(search_index_path(filePath), options.durability);
+                write_search_index(index);
+                index.commit();
             }
 
-            // Pretty print JSON with 4-space indentation
-            file << j.dump(4);
-            file.close();
-
             std::cout << "Successfully saved library to: " << filePath << '\n';
             return true;
 
@@ -183,18 +262,11 @@ namespace edx
                 return false;
             }
 
-            std::ifstream file(filePath);
-            if (!file.is_open())
-			{
-                std::cerr << "Error: Cannot open file for reading: " << filePath << '\n';
-                return false;
-            }
-
-            json j;
-            file >> j;
-            file.close();
+            from_file_data(MappedFile::open(filePath)->view());
 
-            from_json(j);
+            // A missing or stale index is simply rebuilt on the first search
+            if (const auto indexPath = search_index_path(filePath); std::filesystem::exists(indexPath))
+                read_search_index(MappedFile::open(indexPath)->view());
 
             std::cout << "Successfully loaded library from: " << filePath << '\n';
             return true;
@@ -237,7 +309,8 @@ namespace edx
 
         // Validate objects
         std::set<std::string> usedIds;
-        std::set<std::string> usedUniqueIds;
+        std::unordered_set<UniqueId> usedUniqueIds;
+        usedUniqueIds.reserve(objects.size());
 
         for (const auto& obj : objects)
 		{
@@ -255,10 +328,8 @@ namespace edx
                 errors.emplace_back("Object unique ID cannot be empty");
             else
 			{
-                if (usedUniqueIds.contains(obj.uniqueId))
-                    errors.push_back("Duplicate object unique ID: " + obj.uniqueId);
-
-                usedUniqueIds.insert(obj.uniqueId);
+                if (!usedUniqueIds.insert(obj.uniqueId).second)
+                    errors.push_back("Duplicate object unique ID: " + obj.uniqueId.str());
             }
 
             if (obj.assetType.empty())
@@ -277,50 +348,105 @@ namespace edx
 
     void LibraryFile::add_object(const LibraryObject& obj)
     {
-        // Check for duplicate IDs
-        const auto it = std::ranges::find_if(objects,[&obj](const LibraryObject& existing)
-			{
-                return existing.id == obj.id || existing.uniqueId == obj.uniqueId;
-            });
+        add_object(LibraryObject(obj));
+    }
 
-        if (it != objects.end())
-		{
-            std::cerr << "Warning: Object with ID " << obj.id << " already exists. Not adding." << '\n';
+    void LibraryFile::add_object(LibraryObject&& obj)
+    {
+        const std::string id = obj.id;
+        if (m_objectIndex.insert(objects, std::move(obj)) == IdIndex<LibraryObject>::npos)
+        {
+            std::cerr << "Warning: Object with ID " << id << " already exists. Not adding." << '\n';
             return;
         }
 
-        objects.push_back(obj);
+        m_facetIndex.extend(objects);
+        m_searchIndex.extend(objects);
     }
 
-    bool LibraryFile::remove_object(const std::string& id)
+    ObjectIngestReport LibraryFile::add_objects(std::vector<LibraryObject> incoming)
     {
-        if (const auto it = std::ranges::find_if(objects,[&id](const LibraryObject& obj) {return obj.id == id;}); it != objects.end())
+        ObjectIngestReport report;
+        objects.reserve(objects.size() + incoming.size());
+        m_objectIndex.reserve(objects, incoming.size());
+
+        constexpr size_t npos = IdIndex<LibraryObject>::npos;
+        for (size_t i = 0; i < incoming.size(); ++i)
         {
-            objects.erase(it);
-            return true;
+            LibraryObject& obj = incoming[i];
+            if (m_objectIndex.find_id(objects, obj.id) != npos)
+                report.rejected.push_back({i, std::move(obj.id), obj.uniqueId, ObjectIngestReport::Reason::DuplicateId});
+            else if (m_objectIndex.find_unique_id(objects, obj.uniqueId) != npos)
+                report.rejected.push_back({i, std::move(obj.id), obj.uniqueId, ObjectIngestReport::Reason::DuplicateUniqueId});
+            else
+            {
+                m_objectIndex.append(objects, std::move(obj));
+                ++report.added;
+            }
         }
 
-        return false;
+        m_facetIndex.extend(objects);
+        m_searchIndex.extend(objects);
+        return report;
     }
 
-    LibraryObject* LibraryFile::find_object(const std::string& id)
+    bool LibraryFile::remove_object(const std::string& id)
     {
-        const auto it = std::ranges::find_if(objects,[&id](const LibraryObject& obj)
-        {
-            return obj.id == id;
-        });
+        const size_t position = m_objectIndex.find_id(objects, id);
+        if (position == IdIndex<LibraryObject>::npos)
+            return false;
 
-        return it != objects.end() ? &*it : nullptr;
+        m_searchIndex.remove(objects, position);
+        m_facetIndex.remove(objects, position);
+        m_objectIndex.erase(objects, position);
+        return true;
+    }
+
+    size_t LibraryFile::remove_objects(const std::vector<std::string>& ids)
+    {
+        const std::unordered_set<std::string> removed(ids.begin(), ids.end());
+        const size_t count = std::erase_if(objects, [&removed](const LibraryObject& obj) { return removed.contains(obj.id); });
+
+        if (count != 0)
+            invalidate_object_indexes();
+
+        return count;
+    }
+
+    LibraryObject* LibraryFile::find_object(const std::string& id)
+    {
+        const size_t position = m_objectIndex.find_id(objects, id);
+        return position != IdIndex<LibraryObject>::npos ? &objects[position] : nullptr;
     }
 
     const LibraryObject* LibraryFile::find_object(const std::string& id) const
     {
-        const auto it = std::ranges::find_if(objects,[&id](const LibraryObject& obj)
-        {
-            return obj.id == id;
-        });
+        const size_t position = m_objectIndex.find_id(objects, id);
+        return position != IdIndex<LibraryObject>::npos ? &objects[position] : nullptr;
+    }
+
+    LibraryObject* LibraryFile::find_object_by_unique_id(const UniqueId& uniqueId)
+    {
+        const size_t position = m_objectIndex.find_unique_id(objects, uniqueId);
+        return position != IdIndex<LibraryObject>::npos ? &objects[position] : nullptr;
+    }
 
-        return it != objects.end() ? &*it : nullptr;
+    const LibraryObject* LibraryFile::find_object_by_unique_id(const UniqueId& uniqueId) const
+    {
+        const size_t position = m_objectIndex.find_unique_id(objects, uniqueId);
+        return position != IdIndex<LibraryObject>::npos ? &objects[position] : nullptr;
+    }
+
+    size_t LibraryFile::share_properties()
+    {
+        PropertyPool pool;
+        pool.share(objects, [](LibraryObject& obj) -> SharedJson& { return obj.properties; });
+        return pool.size();
+    }
+
+    PropertyColumns LibraryFile::property_columns(PropertySchema schema) const
+    {
+        return PropertyColumns::build(std::move(schema), objects, [](const LibraryObject& obj) -> const SharedJson& { return obj.properties; });
     }
 
     //////////////////////////////////////////////////////
@@ -329,25 +455,76 @@ namespace edx
 
     std::vector<std::string> LibraryFile::get_categories() const
     {
-        std::set<std::string> uniqueCategories;
-        for (const auto& obj : objects)
-		{
-            if (!obj.category.empty())
-                uniqueCategories.insert(obj.category);
-        }
-
-        return {uniqueCategories.begin(), uniqueCategories.end()};
+        return m_facetIndex.values(objects, ObjectFacet::Category);
     }
 
     std::vector<std::string> LibraryFile::get_asset_types() const
     {
-        std::set<std::string> uniqueTypes;
-        for (const auto& obj : objects)
-		{
-            if (!obj.assetType.empty())
-                uniqueTypes.insert(obj.assetType);
+        return m_facetIndex.values(objects, ObjectFacet::AssetType);
+    }
+
+    std::vector<size_t> LibraryFile::query_objects(const ObjectQuery& query) const
+    {
+        return m_facetIndex.query(objects, query);
+    }
+
+    std::span<const size_t> LibraryFile::objects_with(const ObjectFacet facet, const std::string_view value) const
+    {
+        return m_facetIndex.positions(objects, facet, value);
+    }
+
+    std::vector<std::pair<std::string, size_t>> LibraryFile::facet_counts(const ObjectFacet facet) const
+    {
+        return m_facetIndex.counts(objects, facet);
+    }
+
+    std::vector<std::pair<std::string, size_t>> LibraryFile::facet_counts(const ObjectFacet facet, const ObjectQuery& query) const
+    {
+        return m_facetIndex.counts(objects, facet, query);
+    }
+
+    //////////////////////////////////////////////////////
+    // Search
+    //////////////////////////////////////////////////////
+
+    std::vector<SearchHit> LibraryFile::search_objects(const std::string_view query, const size_t limit) const
+    {
+        return m_searchIndex.search(objects, query, limit);
+    }
+
+    void LibraryFile::write_search_index(OutputSink& sink) const
+    {
+        m_searchIndex.write(sink, objects);
+    }
+
+    bool LibraryFile::read_search_index(const std::string_view data)
+    {
+        return m_searchIndex.read(objects, data);
+    }
+
+    std::filesystem::path LibraryFile::search_index_path(const std::filesystem::path& filePath)
+    {
+        std::filesystem::path path = filePath;
+        path += ".search";
+        return path;
+    }
+
+    std::vector<LibrarySearchHit> search_libraries(const std::span<const LibraryFile* const> libraries, const std::string_view query, const size_t limit)
+    {
+        // The overall best are among the best of each library
+        std::vector<LibrarySearchHit> hits;
+        for (size_t i = 0; i < libraries.size(); ++i)
+        {
+            for (const SearchHit& hit : libraries[i]->search_objects(query, limit))
+                hits.push_back({i, hit.position, hit.score});
         }
-        return {uniqueTypes.begin(), uniqueTypes.end()};
+
+        const auto better = [](const LibrarySearchHit& a, const LibrarySearchHit& b) { return a.score > b.score; };
+        std::ranges::stable_sort(hits, better);
+        if (hits.size() > limit)
+            hits.resize(limit);
+
+        return hits;
     }
 
 } // namespace edx
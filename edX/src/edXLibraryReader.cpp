@@ -83,7 +83,9 @@ namespace ProjectLibrarys
                 {
                     edx::LibraryObject libraryObject;
                     std::getline(file, libraryObject.id);
-                    std::getline(file, libraryObject.uniqueId);
+                    std::string uniqueId;
+                    std::getline(file, uniqueId);
+                    libraryObject.uniqueId = uniqueId;
                     std::getline(file, libraryObject.assetType);
 
                     // Parse properties as JSON string
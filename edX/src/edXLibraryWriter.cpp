@@ -75,7 +75,7 @@ namespace edx
 	    for (const auto &object : objects)
 	    {
 	        file << "[Object]" << "Id=" << object.id
-	             << "UniqueId=" << (object.uniqueId.empty() ? generateUniqueId() : object.uniqueId)
+	             << "UniqueId=" << (object.uniqueId.empty() ? generateUniqueId() : object.uniqueId.str())
 	             << "AssetType=" << object.assetType << "Properties=" << object.properties << "\n";
 	    }
 	}
@@ -23,6 +23,7 @@
 * Created: 11/7/2025
 * -------------------------------------------------------
 */
+#include <sstream>
 #include <edX/include/edXManager.h>
 #include <edX/include/edXTimeUtils.h>
 
@@ -147,6 +148,101 @@ namespace edx
         }
     }
 
+    std::unique_ptr<LazyEdxProject> EdxManager::open_project_lazy(const std::string& filePath)
+    {
+        try
+        {
+            auto project = std::make_unique<LazyEdxProject>();
+
+            if (!project->open(filePath))
+            {
+                m_pImpl->reportError("Failed to open project: " + filePath);
+                return nullptr;
+            }
+
+            return project;
+        }
+        catch (const std::exception& e)
+        {
+            m_pImpl->reportError("Exception opening project: " + std::string(e.what()));
+            return nullptr;
+        }
+    }
+
+    std::unique_ptr<EdxProject> EdxManager::load_binary_project(
+        const std::string& filePath,
+        const ProgressCallback &progressCallback)
+    {
+        try
+        {
+            if (progressCallback)
+                progressCallback(0.0f, "Loading binary project file...");
+
+            auto project = std::make_unique<EdxProject>();
+
+            if (!project->load_from_binary_file(filePath))
+            {
+                m_pImpl->reportError("Failed to load binary project from: " + filePath);
+                return nullptr;
+            }
+
+            if (progressCallback)
+                progressCallback(1.0f, "Project loaded successfully");
+
+            return project;
+        }
+        catch (const std::exception& e)
+        {
+            m_pImpl->reportError("Exception loading binary project: " + std::string(e.what()));
+            return nullptr;
+        }
+    }
+
+    bool EdxManager::save_binary_project(
+        const EdxProject& project,
+        const std::string& filePath,
+        const ProgressCallback &progressCallback)
+    {
+        try
+        {
+            if (progressCallback)
+                progressCallback(0.0f, "Validating project...");
+
+            if (auto errors = validate_project(project); !errors.empty())
+            {
+                std::string errorMsg = "Project validation failed: ";
+                for (const auto& error : errors)
+                {
+                    errorMsg += error + "; ";
+                }
+
+                m_pImpl->reportError(errorMsg);
+                return false;
+            }
+
+            if (progressCallback)
+                progressCallback(0.5f, "Saving binary project file...");
+
+            // Update edit date
+            const_cast<EdxProject&>(project).project.editDate = std::chrono::system_clock::now();
+
+            bool result = project.save_to_binary_file(filePath);
+
+            if (progressCallback)
+                progressCallback(1.0f, result ? "Project saved successfully" : "Failed to save project");
+
+            if (!result)
+                m_pImpl->reportError("Failed to save binary project to: " + filePath);
+
+            return result;
+        }
+        catch (const std::exception& e)
+        {
+            m_pImpl->reportError("Exception saving binary project: " + std::string(e.what()));
+            return false;
+        }
+    }
+
     // Library operations
     std::unique_ptr<LibraryFile> EdxManager::create_library(
         const std::string& libraryName,
@@ -254,28 +350,22 @@ namespace edx
 
     bool EdxManager::is_valid_project_file(const std::string& filePath)
     {
-        try
-        {
-            EdxProject project;
-            return project.load_from_file(filePath);
-        }
-        catch (...)
-        {
-            return false;
-        }
+        return ProjectFileHeader::probe(filePath).has_value();
     }
 
     bool EdxManager::is_valid_library_file(const std::string& filePath)
     {
-        try
-        {
-            LibraryFile library;
-            return library.load_from_file(filePath);
-        }
-        catch (...)
-        {
-            return false;
-        }
+        return LibraryFileHeader::probe(filePath).has_value();
+    }
+
+    std::optional<ProjectFileHeader> EdxManager::read_project_header(const std::string& filePath) const
+    {
+        return ProjectFileHeader::probe(filePath);
+    }
+
+    std::optional<LibraryFileHeader> EdxManager::read_library_header(const std::string& filePath) const
+    {
+        return LibraryFileHeader::probe(filePath);
     }
 
     // Error and progress handling
@@ -301,13 +391,12 @@ namespace edx
     {
         try
         {
-            json j;
-            project.to_json(j);
-
-            if (prettyPrint)
-                return j.dump(4); // 4-space indentation
+            SaveOptions options;
+            options.prettyPrint = prettyPrint;
 
-            return j.dump();
+            std::ostringstream stream;
+            project.write_json(stream, options);
+            return stream.str();
         }
         catch (const std::exception& e)
         {
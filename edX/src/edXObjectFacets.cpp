@@ -0,0 +1,269 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXObjectFacets.cpp
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <edX/include/edXLibraryFile.h>
+#include <edX/include/edXObjectFacets.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    namespace
+    {
+        // Number of positions two ascending lists share
+        size_t count_common(const std::vector<size_t>& a, const std::vector<size_t>& b)
+        {
+            size_t count = 0;
+            auto i = a.begin();
+            auto j = b.begin();
+            while (i != a.end() && j != b.end())
+            {
+                if (*i < *j)
+                    ++i;
+                else if (*j < *i)
+                    ++j;
+                else
+                {
+                    ++count;
+                    ++i;
+                    ++j;
+                }
+            }
+
+            return count;
+        }
+    }
+
+    void FacetIndex::rebuild(const std::vector<LibraryObject>& objects)
+    {
+        for (auto& postings : m_postings)
+            postings.clear();
+
+        m_size = 0;
+        m_valid = true;
+        extend(objects);
+    }
+
+    void FacetIndex::extend(const std::vector<LibraryObject>& objects)
+    {
+        // Not current; the next query rebuilds it anyway
+        if (!m_valid || objects.size() < m_size)
+            return;
+
+        for (size_t i = m_size; i < objects.size(); ++i)
+            add(objects[i], i);
+
+        m_data = objects.data();
+        m_size = objects.size();
+    }
+
+    template<typename Visitor>
+    bool FacetIndex::visit_values(const LibraryObject& object, Visitor visit)
+    {
+        if (!object.category.empty() && !visit(m_postings[static_cast<size_t>(ObjectFacet::Category)], object.category))
+            return false;
+
+        if (!object.assetType.empty() && !visit(m_postings[static_cast<size_t>(ObjectFacet::AssetType)], object.assetType))
+            return false;
+
+        for (auto tag = object.tags.begin(); tag != object.tags.end(); ++tag)
+        {
+            // A tag listed twice on one object is indexed once
+            if (tag->empty() || std::find(object.tags.begin(), tag, *tag) != tag)
+                continue;
+
+            if (!visit(m_postings[static_cast<size_t>(ObjectFacet::Tag)], *tag))
+                return false;
+        }
+
+        return true;
+    }
+
+    void FacetIndex::add(const LibraryObject& object, const size_t position)
+    {
+        visit_values(object, [position](Postings& postings, const std::string& value)
+        {
+            postings[value].push_back(position);
+            return true;
+        });
+    }
+
+    void FacetIndex::remove(const std::vector<LibraryObject>& objects, const size_t position)
+    {
+        if (!m_valid || m_size != objects.size() || m_data != objects.data())
+        {
+            m_valid = false;
+            return;
+        }
+
+        // A list without the expected entry means a field was edited in place
+        // without an invalidation; fall back to a rebuild
+        const bool removed = visit_values(objects[position], [position](Postings& postings, const std::string& value)
+        {
+            const auto found = postings.find(value);
+            if (found == postings.end())
+                return false;
+
+            auto& list = found->second;
+            const auto it = std::ranges::lower_bound(list, position);
+            if (it == list.end() || *it != position)
+                return false;
+
+            list.erase(it);
+            if (list.empty())
+                postings.erase(found);
+
+            return true;
+        });
+
+        // The last object takes over the position; it is the back of each of its lists
+        const size_t last = objects.size() - 1;
+        const bool moved = removed && (position == last || visit_values(objects[last], [position, last](Postings& postings, const std::string& value)
+        {
+            const auto found = postings.find(value);
+            if (found == postings.end() || found->second.back() != last)
+                return false;
+
+            auto& list = found->second;
+            list.pop_back();
+            list.insert(std::ranges::lower_bound(list, position), position);
+            return true;
+        }));
+
+        if (!moved)
+        {
+            m_valid = false;
+            return;
+        }
+
+        m_size = last;
+    }
+
+    void FacetIndex::ensure(const std::vector<LibraryObject>& objects)
+    {
+        if (!m_valid || m_size != objects.size() || m_data != objects.data())
+            rebuild(objects);
+    }
+
+    std::span<const size_t> FacetIndex::positions(const std::vector<LibraryObject>& objects, const ObjectFacet facet, const std::string_view value)
+    {
+        ensure(objects);
+        const auto& map = postings(facet);
+        const auto it = map.find(value);
+        if (it == map.end())
+            return {};
+
+        return it->second;
+    }
+
+    std::vector<std::string> FacetIndex::values(const std::vector<LibraryObject>& objects, const ObjectFacet facet)
+    {
+        ensure(objects);
+        std::vector<std::string> values;
+        values.reserve(postings(facet).size());
+        for (const auto& [value, list] : postings(facet))
+            values.push_back(value);
+
+        return values;
+    }
+
+    std::vector<std::pair<std::string, size_t>> FacetIndex::counts(const std::vector<LibraryObject>& objects, const ObjectFacet facet)
+    {
+        ensure(objects);
+        std::vector<std::pair<std::string, size_t>> counts;
+        counts.reserve(postings(facet).size());
+        for (const auto& [value, list] : postings(facet))
+            counts.emplace_back(value, list.size());
+
+        return counts;
+    }
+
+    std::vector<size_t> FacetIndex::query(const std::vector<LibraryObject>& objects, const ObjectQuery& query)
+    {
+        ensure(objects);
+
+        std::vector<const std::vector<size_t>*> lists;
+        const auto require = [&](const ObjectFacet facet, const std::string& value)
+        {
+            if (value.empty())
+                return true;
+
+            const auto& map = postings(facet);
+            const auto it = map.find(value);
+            if (it == map.end())
+                return false;
+
+            lists.push_back(&it->second);
+            return true;
+        };
+
+        bool possible = require(ObjectFacet::Category, query.category) && require(ObjectFacet::AssetType, query.assetType);
+        for (const auto& tag : query.tags)
+            possible = possible && require(ObjectFacet::Tag, tag);
+
+        if (!possible)
+            return {};
+
+        if (lists.empty())
+        {
+            std::vector<size_t> all(objects.size());
+            for (size_t i = 0; i < all.size(); ++i)
+                all[i] = i;
+
+            return all;
+        }
+
+        // Start from the shortest list and probe the longer ones
+        std::ranges::sort(lists, {}, [](const std::vector<size_t>* list) { return list->size(); });
+        std::vector<size_t> result = *lists.front();
+        for (size_t i = 1; i < lists.size() && !result.empty(); ++i)
+        {
+            const std::vector<size_t>& list = *lists[i];
+            std::erase_if(result, [&list](const size_t position) { return !std::ranges::binary_search(list, position); });
+        }
+
+        return result;
+    }
+
+    std::vector<std::pair<std::string, size_t>> FacetIndex::counts(const std::vector<LibraryObject>& objects, const ObjectFacet facet, const ObjectQuery& query)
+    {
+        const std::vector<size_t> matches = this->query(objects, query);
+        if (matches.size() == objects.size())
+            return counts(objects, facet);
+
+        std::vector<std::pair<std::string, size_t>> counts;
+        for (const auto& [value, list] : postings(facet))
+        {
+            if (const size_t count = count_common(matches, list); count != 0)
+                counts.emplace_back(value, count);
+        }
+
+        return counts;
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,621 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXObjectSearch.cpp
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <edX/include/edXFileIO.h>
+#include <edX/include/edXLibraryFile.h>
+#include <edX/include/edXObjectSearch.h>
+#include <edX/src/edXHash.h>
+
+/// ----------------------------------------------------------------------------
+
+/*
+ * Posting entries pack the object position above three field bits (1 = name,
+ * 2 = tags, 4 = description) telling where the trigram occurs, so lists sort
+ * by position and a query knows which fields can hold each word.
+ *
+ * Serialized layout (little-endian):
+ *
+ *   "EDXS" u16 version u16 reserved
+ *   u64 object count, u64 fingerprint of the indexed text
+ *   u32 trigram count, then per trigram: u32 trigram, u32 count, count x u32 entry
+ */
+
+static_assert(std::endian::native == std::endian::little, "The search index reader and writer assume a little-endian host");
+
+namespace edx
+{
+    namespace
+    {
+        constexpr char SEARCH_MAGIC[4] = {'E', 'D', 'X', 'S'};
+        constexpr uint16_t SEARCH_VERSION = 1;
+
+        constexpr uint32_t FIELD_NAME = 1;
+        constexpr uint32_t FIELD_TAGS = 2;
+        constexpr uint32_t FIELD_DESCRIPTION = 4;
+        constexpr uint32_t FIELD_ALL = FIELD_NAME | FIELD_TAGS | FIELD_DESCRIPTION;
+        constexpr uint32_t FIELD_BITS = 3;
+        constexpr size_t MAX_OBJECTS = size_t{1} << (32 - FIELD_BITS);
+
+        constexpr uint32_t SCORE_NAME = 10;
+        constexpr uint32_t SCORE_NAME_START = 5;
+        constexpr uint32_t SCORE_WORD_START = 3;
+        constexpr uint32_t SCORE_EXACT_NAME = 20;
+        constexpr uint32_t SCORE_TAG = 6;
+        constexpr uint32_t SCORE_TAG_PART = 4;
+        constexpr uint32_t SCORE_DESCRIPTION = 1;
+
+        constexpr uint32_t entry(const size_t position, const uint32_t fields) { return static_cast<uint32_t>(position) << FIELD_BITS | fields; }
+        constexpr uint32_t entry_position(const uint32_t value) { return value >> FIELD_BITS; }
+        constexpr uint32_t entry_fields(const uint32_t value) { return value & FIELD_ALL; }
+
+        // ASCII upper case to lower case; other bytes, including UTF-8, unchanged
+        constexpr std::array<char, 256> FOLD = []
+        {
+            std::array<char, 256> table{};
+            for (int c = 0; c < 256; ++c)
+                table[c] = static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+
+            return table;
+        }();
+
+        char fold(const char c)
+        {
+            return FOLD[static_cast<unsigned char>(c)];
+        }
+
+        bool fold_equal(const std::string_view a, const std::string_view b)
+        {
+            return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const char x, const char y) { return fold(x) == fold(y); });
+        }
+
+        // Position of needle (already folded) in text, ignoring case; npos if absent
+        size_t fold_find(const std::string_view text, const std::string_view needle)
+        {
+            if (needle.empty())
+                return 0;
+
+            const char first = needle.front();
+            for (size_t i = 0; i + needle.size() <= text.size(); ++i)
+            {
+                if (fold(text[i]) != first)
+                    continue;
+
+                size_t j = 1;
+                while (j < needle.size() && fold(text[i + j]) == needle[j])
+                    ++j;
+
+                if (j == needle.size())
+                    return i;
+            }
+
+            return std::string_view::npos;
+        }
+
+        uint32_t trigram(const char* text)
+        {
+            return static_cast<uint32_t>(static_cast<unsigned char>(fold(text[0]))) << 16
+                 | static_cast<uint32_t>(static_cast<unsigned char>(fold(text[1]))) << 8
+                 | static_cast<uint32_t>(static_cast<unsigned char>(fold(text[2])));
+        }
+
+        // Distinct trigrams of the searchable fields of an object, each with the fields holding it
+        void object_trigrams(std::vector<std::pair<uint32_t, uint32_t>>& keys, const LibraryObject& object)
+        {
+            keys.clear();
+            const auto add = [&keys](const std::string_view text, const uint32_t field)
+            {
+                for (size_t i = 0; i + 3 <= text.size(); ++i)
+                    keys.emplace_back(trigram(text.data() + i), field);
+            };
+
+            add(object.name, FIELD_NAME);
+            add(object.description, FIELD_DESCRIPTION);
+            for (const auto& tag : object.tags)
+                add(tag, FIELD_TAGS);
+
+            std::ranges::sort(keys);
+            size_t out = 0;
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                if (out != 0 && keys[out - 1].first == keys[i].first)
+                    keys[out - 1].second |= keys[i].second;
+                else
+                    keys[out++] = keys[i];
+            }
+
+            keys.resize(out);
+        }
+
+        // FNV-1a over the searchable fields, so a stale serialized index is detected
+        uint64_t fingerprint(const std::vector<LibraryObject>& objects)
+        {
+            uint64_t hash = detail::FNV_OFFSET;
+            const auto mix = [&hash](const std::string_view text)
+            {
+                // Field separator so "ab"+"c" and "a"+"bc" differ
+                hash = detail::fnv1a("\xff", detail::fnv1a(text, hash));
+            };
+
+            for (const auto& object : objects)
+            {
+                mix(object.name);
+                mix(object.description);
+                for (const auto& tag : object.tags)
+                    mix(tag);
+
+                mix({});
+            }
+
+            return hash;
+        }
+
+        // Best score a word can reach in the given fields
+        uint32_t word_bound(const uint32_t fields)
+        {
+            if (fields & FIELD_NAME)
+                return SCORE_NAME + SCORE_NAME_START;
+
+            if (fields & FIELD_TAGS)
+                return SCORE_TAG;
+
+            return fields & FIELD_DESCRIPTION ? SCORE_DESCRIPTION : 0;
+        }
+
+        // Score of one query word against an object; 0 if it does not occur
+        uint32_t score_word(const LibraryObject& object, const std::string_view word, const uint32_t fields)
+        {
+            if (fields & FIELD_NAME)
+            {
+                if (const size_t pos = fold_find(object.name, word); pos != std::string_view::npos)
+                {
+                    if (pos == 0)
+                        return SCORE_NAME + SCORE_NAME_START;
+
+                    const char before = object.name[pos - 1];
+                    const bool wordStart = !(before >= 'a' && before <= 'z') && !(before >= 'A' && before <= 'Z') && !(before >= '0' && before <= '9');
+                    return wordStart ? SCORE_NAME + SCORE_WORD_START : SCORE_NAME;
+                }
+            }
+
+            uint32_t best = 0;
+            if (fields & FIELD_TAGS)
+            {
+                for (const auto& tag : object.tags)
+                {
+                    if (fold_equal(tag, word))
+                        return SCORE_TAG;
+
+                    if (best == 0 && fold_find(tag, word) != std::string_view::npos)
+                        best = SCORE_TAG_PART;
+                }
+            }
+
+            if (best == 0 && (fields & FIELD_DESCRIPTION) && fold_find(object.description, word) != std::string_view::npos)
+                best = SCORE_DESCRIPTION;
+
+            return best;
+        }
+
+        // Keep the entries of current whose position is in list, narrowing their
+        // fields to those the list entry shares; entries left without a field go
+        void intersect(std::vector<uint32_t>& current, const std::vector<uint32_t>& list, const bool sameWord)
+        {
+            size_t out = 0;
+            auto it = list.begin();
+            const bool sparse = list.size() > current.size() * 8;
+            for (const uint32_t value : current)
+            {
+                const uint32_t position = entry_position(value);
+                if (sparse)
+                    it = std::lower_bound(it, list.end(), entry(position, 0));
+                else
+                {
+                    while (it != list.end() && entry_position(*it) < position)
+                        ++it;
+                }
+
+                if (it == list.end())
+                    break;
+
+                if (entry_position(*it) != position)
+                    continue;
+
+                // Trigrams of one word must all occur in the same field
+                const uint32_t fields = sameWord ? entry_fields(value) & entry_fields(*it) : entry_fields(value);
+                if (fields != 0)
+                    current[out++] = entry(position, fields);
+            }
+
+            current.resize(out);
+        }
+
+        template<typename T>
+        void put(std::string& out, const T value)
+        {
+            out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template<typename T>
+        bool get(std::string_view& in, T& value)
+        {
+            if (in.size() < sizeof(T))
+                return false;
+
+            std::memcpy(&value, in.data(), sizeof(T));
+            in.remove_prefix(sizeof(T));
+            return true;
+        }
+    }
+
+    void SearchIndex::rebuild(const std::vector<LibraryObject>& objects)
+    {
+        m_postings.clear();
+        m_size = 0;
+        m_valid = true;
+        extend(objects);
+    }
+
+    void SearchIndex::extend(const std::vector<LibraryObject>& objects)
+    {
+        // Not current; the next search rebuilds it anyway
+        if (!m_valid || objects.size() < m_size)
+            return;
+
+        if (objects.size() > MAX_OBJECTS)
+        {
+            m_valid = false;
+            throw std::length_error("Too many objects for the search index");
+        }
+
+        std::vector<std::pair<uint32_t, uint32_t>> keys;
+        for (size_t i = m_size; i < objects.size(); ++i)
+        {
+            object_trigrams(keys, objects[i]);
+            for (const auto& [key, fields] : keys)
+                m_postings[key].push_back(entry(i, fields));
+        }
+
+        m_data = objects.data();
+        m_size = objects.size();
+    }
+
+    void SearchIndex::remove(const std::vector<LibraryObject>& objects, const size_t position)
+    {
+        if (!m_valid || m_size != objects.size() || m_data != objects.data())
+        {
+            m_valid = false;
+            return;
+        }
+
+        // A list without the expected entry means text was edited in place
+        // without an invalidation; fall back to a rebuild
+        std::vector<std::pair<uint32_t, uint32_t>> keys;
+        object_trigrams(keys, objects[position]);
+        for (const auto& [key, fields] : keys)
+        {
+            const auto found = m_postings.find(key);
+            if (found == m_postings.end())
+            {
+                m_valid = false;
+                return;
+            }
+
+            auto& list = found->second;
+            const auto it = std::ranges::lower_bound(list, entry(position, 0));
+            if (it == list.end() || entry_position(*it) != position)
+            {
+                m_valid = false;
+                return;
+            }
+
+            list.erase(it);
+            if (list.empty())
+                m_postings.erase(found);
+        }
+
+        // The last object takes over the position; it is the back of each of its lists
+        const size_t last = objects.size() - 1;
+        if (position != last)
+        {
+            object_trigrams(keys, objects[last]);
+            for (const auto& [key, fields] : keys)
+            {
+                const auto found = m_postings.find(key);
+                if (found == m_postings.end() || entry_position(found->second.back()) != last)
+                {
+                    m_valid = false;
+                    return;
+                }
+
+                auto& list = found->second;
+                const uint32_t moved = entry(position, entry_fields(list.back()));
+                list.pop_back();
+                list.insert(std::ranges::lower_bound(list, moved), moved);
+            }
+        }
+
+        m_size = last;
+    }
+
+    void SearchIndex::ensure(const std::vector<LibraryObject>& objects)
+    {
+        if (!m_valid || m_size != objects.size() || m_data != objects.data())
+            rebuild(objects);
+    }
+
+    std::vector<SearchHit> SearchIndex::search(const std::vector<LibraryObject>& objects, const std::string_view query, const size_t limit)
+    {
+        ensure(objects);
+
+        // Folded words of the query
+        std::vector<std::string> words;
+        for (size_t i = 0; i < query.size();)
+        {
+            const size_t end = std::min(query.find(' ', i), query.size());
+            if (end > i)
+            {
+                std::string word(query.substr(i, end - i));
+                std::ranges::transform(word, word.begin(), fold);
+                words.push_back(std::move(word));
+            }
+
+            i = end + 1;
+        }
+
+        if (words.empty() || limit == 0)
+            return {};
+
+        // Candidates per word: objects holding all its trigrams within one field.
+        // Words under three bytes have no trigrams and may occur anywhere.
+        std::vector<std::vector<uint32_t>> wordCandidates(words.size());
+        std::vector<bool> indexed(words.size(), false);
+        for (size_t w = 0; w < words.size(); ++w)
+        {
+            const std::string& word = words[w];
+            std::vector<const std::vector<uint32_t>*> lists;
+            for (size_t i = 0; i + 3 <= word.size(); ++i)
+            {
+                const auto it = m_postings.find(trigram(word.data() + i));
+                if (it == m_postings.end())
+                    return {};
+
+                lists.push_back(&it->second);
+            }
+
+            if (lists.empty())
+                continue;
+
+            std::ranges::sort(lists);
+            const auto [first, last] = std::ranges::unique(lists);
+            lists.erase(first, last);
+            std::ranges::sort(lists, {}, [](const std::vector<uint32_t>* list) { return list->size(); });
+
+            std::vector<uint32_t>& candidates = wordCandidates[w];
+            candidates = *lists.front();
+            for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i)
+                intersect(candidates, *lists[i], true);
+
+            if (candidates.empty())
+                return {};
+
+            indexed[w] = true;
+        }
+
+        // Objects matching every indexed word, with the fields each word may be in
+        std::vector<size_t> order;
+        for (size_t w = 0; w < words.size(); ++w)
+        {
+            if (indexed[w])
+                order.push_back(w);
+        }
+
+        std::ranges::sort(order, {}, [&](const size_t w) { return wordCandidates[w].size(); });
+
+        std::vector<uint32_t> positions;
+        if (order.empty())
+        {
+            positions.resize(objects.size());
+            for (size_t i = 0; i < positions.size(); ++i)
+                positions[i] = entry(i, 0);
+        }
+        else
+        {
+            positions = wordCandidates[order.front()];
+            for (size_t i = 1; i < order.size() && !positions.empty(); ++i)
+                intersect(positions, wordCandidates[order[i]], false);
+        }
+
+        // Fields word w may occupy in a candidate; the entries carry them for the
+        // word the intersection started from
+        const auto fields_of = [&](const size_t w, const uint32_t value)
+        {
+            if (!indexed[w])
+                return FIELD_ALL;
+
+            if (w == order.front())
+                return entry_fields(value);
+
+            return entry_fields(*std::ranges::lower_bound(wordCandidates[w], entry(entry_position(value), 0)));
+        };
+
+        // Upper bound on each candidate's score; bounds are small, so they are
+        // bucketed rather than sorted
+        std::vector<uint32_t> bounds(positions.size());
+        uint32_t maxBound = 0;
+        for (size_t i = 0; i < positions.size(); ++i)
+        {
+            const uint32_t value = positions[i];
+            uint32_t bound = objects[entry_position(value)].name.size() == query.size() ? SCORE_EXACT_NAME : 0;
+            for (size_t w = 0; w < words.size(); ++w)
+                bound += word_bound(fields_of(w, value));
+
+            bounds[i] = bound;
+            maxBound = std::max(maxBound, bound);
+        }
+
+        std::vector<size_t> bucketStart(maxBound + 2, 0);
+        for (const uint32_t bound : bounds)
+            ++bucketStart[maxBound - bound + 1];
+
+        for (size_t b = 1; b < bucketStart.size(); ++b)
+            bucketStart[b] += bucketStart[b - 1];
+
+        std::vector<std::pair<uint32_t, uint32_t>> bounded(positions.size()); // (bound, entry)
+        for (size_t i = 0; i < positions.size(); ++i)
+            bounded[bucketStart[maxBound - bounds[i]]++] = {bounds[i], positions[i]};
+
+        // Visit in falling bound, then object order; stop once limit hits are
+        // known to beat everything not yet visited. Earlier hits that only tie
+        // the bound may lose to a lower position in the new bucket, so the
+        // count starts from those scoring above it.
+        std::vector<SearchHit> hits;
+        size_t atBound = 0;
+        uint32_t currentBound = 0;
+        for (size_t i = 0; i < bounded.size(); ++i)
+        {
+            const auto [bound, value] = bounded[i];
+            const uint32_t position = entry_position(value);
+            if (i == 0 || bound != currentBound)
+            {
+                currentBound = bound;
+                atBound = static_cast<size_t>(std::ranges::count_if(hits, [bound](const SearchHit& hit) { return hit.score > bound; }));
+                if (atBound >= limit)
+                    break;
+            }
+
+            const LibraryObject& object = objects[position];
+            uint32_t score = 0;
+            for (size_t w = 0; w < words.size(); ++w)
+            {
+                const uint32_t wordScore = score_word(object, words[w], fields_of(w, value));
+                if (wordScore == 0)
+                {
+                    score = 0;
+                    break;
+                }
+
+                score += wordScore;
+            }
+
+            if (score == 0)
+                continue;
+
+            if (fold_equal(object.name, query))
+                score += SCORE_EXACT_NAME;
+
+            hits.push_back({position, score});
+            if (score >= currentBound && ++atBound >= limit)
+                break;
+        }
+
+        // Best score, then object order
+        const auto better = [](const SearchHit& a, const SearchHit& b) { return a.score != b.score ? a.score > b.score : a.position < b.position; };
+        const size_t count = std::min(limit, hits.size());
+        std::partial_sort(hits.begin(), hits.begin() + static_cast<std::ptrdiff_t>(count), hits.end(), better);
+        hits.resize(count);
+        return hits;
+    }
+
+    void SearchIndex::write(OutputSink& sink, const std::vector<LibraryObject>& objects)
+    {
+        ensure(objects);
+
+        // Sorted by trigram so equal indexes serialize identically
+        std::vector<uint32_t> keys;
+        keys.reserve(m_postings.size());
+        for (const auto& [key, list] : m_postings)
+            keys.push_back(key);
+
+        std::ranges::sort(keys);
+
+        std::string out(SEARCH_MAGIC, sizeof(SEARCH_MAGIC));
+        put(out, SEARCH_VERSION);
+        put(out, uint16_t{0});
+        put(out, static_cast<uint64_t>(objects.size()));
+        put(out, fingerprint(objects));
+        put(out, static_cast<uint32_t>(keys.size()));
+        for (const uint32_t key : keys)
+        {
+            const auto& list = m_postings.at(key);
+            put(out, key);
+            put(out, static_cast<uint32_t>(list.size()));
+            out.append(reinterpret_cast<const char*>(list.data()), list.size() * sizeof(uint32_t));
+        }
+
+        sink.write(out.data(), out.size());
+    }
+
+    bool SearchIndex::read(const std::vector<LibraryObject>& objects, std::string_view data)
+    {
+        uint16_t version = 0;
+        uint16_t reserved = 0;
+        uint64_t count = 0;
+        uint64_t hash = 0;
+        uint32_t keyCount = 0;
+        if (data.size() < sizeof(SEARCH_MAGIC) || std::memcmp(data.data(), SEARCH_MAGIC, sizeof(SEARCH_MAGIC)) != 0)
+            return false;
+
+        data.remove_prefix(sizeof(SEARCH_MAGIC));
+        if (!get(data, version) || !get(data, reserved) || !get(data, count) || !get(data, hash) || !get(data, keyCount))
+            return false;
+
+        if (version != SEARCH_VERSION || count != objects.size() || hash != fingerprint(objects))
+            return false;
+
+        std::unordered_map<uint32_t, std::vector<uint32_t>> postings;
+        postings.reserve(keyCount);
+        for (uint32_t i = 0; i < keyCount; ++i)
+        {
+            uint32_t key = 0;
+            uint32_t size = 0;
+            if (!get(data, key) || !get(data, size) || size > data.size() / sizeof(uint32_t))
+                return false;
+
+            std::vector<uint32_t> list(size);
+            std::memcpy(list.data(), data.data(), size * sizeof(uint32_t));
+            data.remove_prefix(size * sizeof(uint32_t));
+
+            if (!std::ranges::is_sorted(list) || (!list.empty() && entry_position(list.back()) >= count))
+                return false;
+
+            postings.emplace(key, std::move(list));
+        }
+
+        m_postings = std::move(postings);
+        m_data = objects.data();
+        m_size = objects.size();
+        m_valid = true;
+        return true;
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,215 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXParallelLoad.cpp
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <span>
+#include <thread>
+#include <edX/src/edXJsonSax.h>
+#include <edX/src/edXJsonSkim.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx::detail
+{
+    namespace
+    {
+        // Work items per thread; a few per thread evens out chunks of uneven cost
+        constexpr size_t CHUNKS_PER_THREAD = 4;
+
+        // A contiguous run of elements from one array section
+        struct ParseJob
+        {
+            const char* key; // One of the section key constants; compared by address
+
+            std::span<const std::string_view> elements;
+            ProjectSections result;
+            std::exception_ptr error;
+        };
+
+        void parse_elements(ParseJob& job)
+        {
+            // Replay the enclosing object and array so each element parses as in a full document
+            ProjectSaxHandler handler(job.result);
+            std::string sectionKey = job.key;
+            handler.start_object(static_cast<std::size_t>(-1));
+            handler.key(sectionKey);
+            handler.start_array(static_cast<std::size_t>(-1));
+
+            for (const auto& element : job.elements)
+                json::sax_parse(element.begin(), element.end(), &handler, json::input_format_t::json, true);
+
+            handler.end_array();
+            handler.end_object();
+        }
+
+        void add_jobs(std::vector<ParseJob>& jobs, const char* key, const std::vector<std::string_view>& elements, const size_t chunkCount)
+        {
+            if (elements.empty())
+                return;
+
+            const size_t chunkSize = (elements.size() + chunkCount - 1) / chunkCount;
+            for (size_t first = 0; first < elements.size(); first += chunkSize)
+            {
+                const size_t count = std::min(chunkSize, elements.size() - first);
+                jobs.push_back({key, std::span(elements).subspan(first, count), {}, nullptr});
+            }
+        }
+
+        template<typename T>
+        std::vector<T> concatenate(std::vector<ParseJob>& jobs, const char* key, std::vector<T> ProjectSections::* field)
+        {
+            size_t total = 0;
+            for (auto& job : jobs)
+            {
+                if (job.key == key)
+                    total += (job.result.*field).size();
+            }
+
+            std::vector<T> combined;
+            combined.reserve(total);
+            for (auto& job : jobs)
+            {
+                if (job.key == key)
+                    std::ranges::move(job.result.*field, std::back_inserter(combined));
+            }
+
+            return combined;
+        }
+    }
+
+    bool parse_project_parallel(const std::string_view text, unsigned int threadCount, EdxProject& target)
+    {
+        if (threadCount == 0)
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+        static constexpr const char* ASSETS_KEY = "Assets";
+        static constexpr const char* LAYERS_KEY = "Layers";
+
+        // Single skim pass: metadata sections are parsed inline, array elements are only delimited
+        JsonSkimmer skimmer(text);
+        if (!skimmer.begin_object())
+            return false;
+
+        ProjectSections sections;
+        std::vector<std::string_view> assetElements, layerElements;
+
+        std::string key;
+        while (skimmer.next_key(key))
+        {
+            if (key == ASSETS_KEY || key == LAYERS_KEY)
+            {
+                // Anything but an array is left to the serial parser's handling
+                if (!skimmer.begin_array())
+                    return false;
+
+                auto& elements = key == ASSETS_KEY ? assetElements : layerElements;
+                elements.clear();
+                while (skimmer.next_element())
+                    elements.push_back(skimmer.skip_value());
+
+                continue;
+            }
+
+            const std::string_view value = skimmer.skip_value();
+            if (key == "Project" || key == "Airport" || key == "Libraries" || key == "Settings" || key == "Property-Table")
+            {
+                parse_project_section(key, value, sections);
+            }
+            else if (!json::accept(value.begin(), value.end()))
+            {
+                // Unknown sections are ignored but must still be well-formed; rethrow with the parser's diagnostics
+                [[maybe_unused]] const json invalid = json::parse(value.begin(), value.end());
+            }
+        }
+
+        const size_t chunkCount = static_cast<size_t>(threadCount) * CHUNKS_PER_THREAD;
+        std::vector<ParseJob> jobs;
+        add_jobs(jobs, ASSETS_KEY, assetElements, chunkCount);
+        add_jobs(jobs, LAYERS_KEY, layerElements, chunkCount);
+
+        std::atomic<size_t> nextJob = 0;
+        const auto worker = [&jobs, &nextJob]
+        {
+            for (size_t i = nextJob++; i < jobs.size(); i = nextJob++)
+            {
+                try
+                {
+                    parse_elements(jobs[i]);
+                }
+                catch (...)
+                {
+                    jobs[i].error = std::current_exception();
+                }
+            }
+        };
+
+        {
+            const size_t helperCount = std::min<size_t>(threadCount, jobs.size()) - (jobs.empty() ? 0 : 1);
+            std::vector<std::jthread> helpers;
+            helpers.reserve(helperCount);
+            for (size_t i = 0; i < helperCount; ++i)
+                helpers.emplace_back(worker);
+
+            worker();
+        }
+
+        // Metadata sections already threw during the skim; of the element
+        // errors, report the first failing job in queue order, so an Assets
+        // error wins over a Layers error whatever their order in the file
+        for (const auto& job : jobs)
+        {
+            if (job.error)
+                std::rethrow_exception(job.error);
+        }
+
+        // Property refs index into their job's assets; rebase them onto the combined vector
+        size_t assetOffset = 0;
+        for (auto& job : jobs)
+        {
+            if (job.key != ASSETS_KEY)
+                continue;
+
+            for (const auto& ref : job.result.propertyRefs)
+                sections.propertyRefs.push_back({assetOffset + ref.asset, ref.index});
+            assetOffset += job.result.assets.size();
+        }
+
+        sections.assets = concatenate(jobs, ASSETS_KEY, &ProjectSections::assets);
+        sections.layers = concatenate(jobs, LAYERS_KEY, &ProjectSections::layers);
+
+        // Each job interned its own blobs; share equal ones across jobs too
+        sections.resolve_property_refs(sections.assets);
+        sections.properties.share(sections.assets, [](SceneAsset& asset) -> SharedJson& { return asset.otherProperties; });
+
+        sections.commit(target);
+        return true;
+    }
+
+} // namespace edx::detail
+
+/// ----------------------------------------------------------------------------
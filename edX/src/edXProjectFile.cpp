@@ -23,16 +23,84 @@
 * Created: 11/7/2025
 * -------------------------------------------------------
 */
-#include <fstream>
 #include <iostream>
+#include <istream>
 #include <memory>
+#include <optional>
 #include <edX/include/edXProjectFile.h>
+#include <edX/include/edXSpatialIndex.h>
 #include <edX/include/edXTimeUtils.h>
+#include <edX/src/edXCompression.h>
+#include <edX/src/edXJsonSax.h>
+#include <edX/src/edXJsonWriter.h>
 
 /// ----------------------------------------------------------------------------
 
 namespace edx
 {
+    namespace
+    {
+        // Direct writers for the bulky sections. Keys are emitted in the sorted
+        // order nlohmann uses so the output matches the to_json() + dump() path.
+        void write_library_reference(detail::JsonWriter& writer, const LibraryReference& lib)
+        {
+            writer.begin_object();
+            writer.member("Library", lib.name);
+            writer.member("entry-count", lib.entryCount);
+            writer.member("local-path", lib.localPath);
+            writer.member("short-id", lib.shortId);
+            writer.member("uuid", lib.uuid);
+            writer.member("version", lib.version);
+            writer.end_object();
+        }
+
+        // With a table, other-properties are written as an index into it
+        void write_scene_asset(detail::JsonWriter& writer, const SceneAsset& asset, PropertyTable* table)
+        {
+            writer.begin_object();
+            writer.member("altitude", asset.altitude);
+            writer.member("associated-library", asset.associatedLibrary.str());
+            writer.member("group-id", asset.groupId.str());
+            writer.member("heading", asset.heading);
+            writer.member("hidden", asset.hidden);
+            writer.member("id", asset.id);
+            writer.member("latitude", asset.latitude);
+            writer.member("layer-id", asset.layerId.str());
+            writer.member("locked", asset.locked);
+            writer.member("longitude", asset.longitude);
+            if (!asset.otherProperties.empty())
+            {
+                if (table != nullptr)
+                    writer.member("other-properties-ref", static_cast<int>(table->add(asset.otherProperties)));
+                else
+                    writer.member("other-properties", asset.otherProperties.get());
+            }
+            writer.member("selected", asset.selected);
+            writer.member("unique-id", asset.uniqueId.str());
+            writer.end_object();
+        }
+
+        void write_scene_layer(detail::JsonWriter& writer, const SceneLayer& layer)
+        {
+            writer.begin_object();
+            writer.key("asset-ids");
+            writer.begin_array();
+            for (const auto& assetId : layer.assetIds)
+                writer.value(assetId);
+            writer.end_array();
+            writer.member("description", layer.description);
+            writer.member("hidden", layer.hidden);
+            writer.member("layer-id", layer.layerId);
+            if (!layer.layerProperties.empty())
+                writer.member("layer-properties", layer.layerProperties);
+            writer.member("locked", layer.locked);
+            writer.member("name", layer.name);
+            writer.member("opacity", layer.opacity);
+            writer.member("z-order", layer.zOrder);
+            writer.end_object();
+        }
+    }
+
     // ProjectInfo JSON serialization
     void ProjectInfo::to_json(json& j) const
     {
@@ -285,6 +353,12 @@ namespace edx
             }
         }
 
+        // Equal property blobs share one tree, as on the streaming path
+        PropertyPool properties;
+        std::vector<SharedJson> propertyTable;
+        if (j.contains("Property-Table"))
+            propertyTable = detail::load_property_table(j["Property-Table"], properties);
+
         assets.clear();
         if (j.contains("Assets"))
 		{
@@ -292,9 +366,14 @@ namespace edx
 			{
                 SceneAsset asset;
                 asset.from_json(assetJson);
+                if (assetJson.contains("other-properties-ref"))
+                    asset.otherProperties = detail::property_table_entry(propertyTable, assetJson["other-properties-ref"].get<int64_t>());
+                else
+                    asset.otherProperties = properties.intern(asset.otherProperties);
                 assets.push_back(asset);
             }
         }
+        m_assetIndex.invalidate();
 
         layers.clear();
         if (j.contains("Layers"))
@@ -311,24 +390,104 @@ namespace edx
             settings = j["Settings"];
     }
 
+    void EdxProject::from_json_stream(std::istream& stream)
+    {
+        detail::ProjectSections sections;
+        detail::ProjectSaxHandler handler(sections);
+
+        // Non-strict like operator>>: parsing stops after the root value
+        json::sax_parse(stream, &handler, json::input_format_t::json, false);
+        sections.commit(*this);
+    }
+
+    void EdxProject::from_json_buffer(const std::string_view text, const LoadOptions& options)
+    {
+        if (options.threadCount != 1 && detail::parse_project_parallel(text, options.threadCount, *this))
+            return;
+
+        detail::ProjectSections sections;
+        detail::ProjectSaxHandler handler(sections);
+
+        json::sax_parse(text.data(), text.data() + text.size(), &handler, json::input_format_t::json, false);
+        sections.commit(*this);
+    }
+
+    void EdxProject::write_json(OutputSink& sink, const SaveOptions& options) const
+    {
+        detail::JsonWriter writer(sink, options.prettyPrint);
+
+        // Metadata sections are tiny; reuse their to_json for identical output
+        json projectJson, airportJson;
+        project.to_json(projectJson);
+        airport.to_json(airportJson);
+
+        writer.begin_object();
+        writer.member("Airport", airportJson);
+
+        std::optional<PropertyTable> propertyTable;
+        if (options.propertyTable)
+            propertyTable.emplace();
+
+        writer.key("Assets");
+        writer.begin_array();
+        if (options.spatialOrder)
+        {
+            for (const size_t index : hilbert_order(assets))
+                write_scene_asset(writer, assets[index], propertyTable ? &*propertyTable : nullptr);
+        }
+        else
+        {
+            for (const auto& asset : assets)
+                write_scene_asset(writer, asset, propertyTable ? &*propertyTable : nullptr);
+        }
+        writer.end_array();
+
+        writer.key("Layers");
+        writer.begin_array();
+        for (const auto& layer : layers)
+            write_scene_layer(writer, layer);
+        writer.end_array();
+
+        writer.key("Libraries");
+        writer.begin_array();
+        for (const auto& lib : libraries)
+            write_library_reference(writer, lib);
+        writer.end_array();
+
+        writer.member("Project", projectJson);
+
+        // Written after the assets have numbered the blobs; readers resolve refs once the document is read
+        if (propertyTable)
+        {
+            writer.key("Property-Table");
+            writer.begin_array();
+            for (const json* value : propertyTable->entries())
+                writer.value(*value);
+            writer.end_array();
+        }
+
+        if (!settings.empty())
+            writer.member("Settings", settings);
+
+        writer.end_object();
+        writer.flush();
+    }
+
+    void EdxProject::write_json(std::ostream& stream, const SaveOptions& options) const
+    {
+        StreamSink sink(stream);
+        write_json(sink, options);
+    }
+
     // File operations
-    bool EdxProject::save_to_file(const std::filesystem::path& filePath) const
+    bool EdxProject::save_to_file(const std::filesystem::path& filePath, const SaveOptions& options) const
     {
         try
 		{
-            json j;
-            to_json(j);
-
-            std::ofstream file(filePath);
-            if (!file.is_open())
-			{
-                std::cerr << "Error: Cannot open file for writing: " << filePath << '\n';
-                return false;
-            }
-
-            // Pretty print JSON with 4-space indentation
-            file << j.dump(4);
-            file.close();
+            // Written to a temporary file and renamed into place on success
+            AtomicFileWriter file(filePath, options.durability);
+            detail::write_with_compression(file, options, [&](OutputSink& sink) { write_json(sink, options); });
+            file.commit();
 
             std::cout << "Successfully saved project to: " << filePath << '\n';
             return true;
@@ -341,7 +500,7 @@ namespace edx
         }
     }
 
-    bool EdxProject::load_from_file(const std::filesystem::path& filePath)
+    bool EdxProject::load_from_file(const std::filesystem::path& filePath, const LoadOptions& options)
     {
         try
 		{
@@ -351,18 +510,22 @@ namespace edx
                 return false;
             }
 
-            std::ifstream file(filePath);
-            if (!file.is_open())
-			{
-                std::cerr << "Error: Cannot open file for reading: " << filePath << '\n';
-                return false;
+            const auto file = MappedFile::open(filePath);
+            if (is_binary_data(file->view()))
+            {
+                from_binary_buffer(file->view());
+            }
+            else if (detail::is_compressed(file->view()))
+            {
+                // Decompressed block by block straight into the streaming parser
+                detail::DecompressingStreamBuf buffer(file->view());
+                std::istream stream(&buffer);
+                from_json_stream(stream);
+            }
+            else
+            {
+                from_json_buffer(file->view(), options);
             }
-
-            json j;
-            file >> j;
-            file.close();
-
-            from_json(j);
 
             std::cout << "Successfully loaded project from: " << filePath << '\n';
             return true;
@@ -443,6 +606,80 @@ namespace edx
         return errors;
     }
 
+    //////////////////////////////////////////////////////
+    // Asset indexes
+    //////////////////////////////////////////////////////
+
+    SceneAsset* EdxProject::find_asset(const std::string& id)
+    {
+        const size_t position = m_assetIndex.find_id(assets, id);
+        return position != AssetIndex::npos ? &assets[position] : nullptr;
+    }
+
+    const SceneAsset* EdxProject::find_asset(const std::string& id) const
+    {
+        const size_t position = m_assetIndex.find_id(assets, id);
+        return position != AssetIndex::npos ? &assets[position] : nullptr;
+    }
+
+    SceneAsset* EdxProject::find_asset_by_unique_id(const UniqueId& uniqueId)
+    {
+        const size_t position = m_assetIndex.find_unique_id(assets, uniqueId);
+        return position != AssetIndex::npos ? &assets[position] : nullptr;
+    }
+
+    const SceneAsset* EdxProject::find_asset_by_unique_id(const UniqueId& uniqueId) const
+    {
+        const size_t position = m_assetIndex.find_unique_id(assets, uniqueId);
+        return position != AssetIndex::npos ? &assets[position] : nullptr;
+    }
+
+    SceneAsset* EdxProject::insert_asset(SceneAsset asset)
+    {
+        const size_t position = m_assetIndex.insert(assets, std::move(asset));
+        return position != AssetIndex::npos ? &assets[position] : nullptr;
+    }
+
+    bool EdxProject::erase_asset(const std::string& id)
+    {
+        const size_t position = m_assetIndex.find_id(assets, id);
+        if (position == AssetIndex::npos)
+            return false;
+
+        m_assetIndex.erase(assets, position);
+        return true;
+    }
+
+    bool EdxProject::erase_asset_by_unique_id(const UniqueId& uniqueId)
+    {
+        const size_t position = m_assetIndex.find_unique_id(assets, uniqueId);
+        if (position == AssetIndex::npos)
+            return false;
+
+        m_assetIndex.erase(assets, position);
+        return true;
+    }
+
+    void EdxProject::sort_assets_spatially()
+    {
+        const std::vector<size_t> order = hilbert_order(assets);
+
+        std::vector<SceneAsset> sorted;
+        sorted.reserve(assets.size());
+        for (const size_t index : order)
+            sorted.push_back(std::move(assets[index]));
+
+        assets = std::move(sorted);
+        m_assetIndex.invalidate();
+    }
+
+    size_t EdxProject::share_properties()
+    {
+        PropertyPool pool;
+        pool.share(assets, [](SceneAsset& asset) -> SharedJson& { return asset.otherProperties; });
+        return pool.size();
+    }
+
 } // namespace edx
 
 /// ----------------------------------------------------------------------------
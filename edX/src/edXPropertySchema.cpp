@@ -0,0 +1,318 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXPropertySchema.cpp
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <edX/include/edXPropertySchema.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    namespace
+    {
+        // Whether write_row gives the value back exactly; integers in a Number
+        // field and unsigned values past int64_t would not survive the column
+        bool round_trips(const PropertyType type, const json& value)
+        {
+            switch (type)
+            {
+                case PropertyType::Integer: return !value.is_number_unsigned() || value.get<uint64_t>() <= std::numeric_limits<int64_t>::max();
+                case PropertyType::Number:  return value.is_number_float();
+                default:                    return true;
+            }
+        }
+    }
+
+    //////////////////////////////////////////////////////
+    // PropertySchema
+    //////////////////////////////////////////////////////
+
+    size_t PropertySchema::add(std::string key, const PropertyType type)
+    {
+        if (const auto existing = find(key))
+        {
+            if (m_fields[*existing].type != type)
+                throw std::runtime_error("Property '" + key + "' is already in the schema with another type");
+
+            return *existing;
+        }
+
+        m_fields.push_back({std::move(key), type});
+        return m_fields.size() - 1;
+    }
+
+    std::optional<size_t> PropertySchema::find(const std::string_view key) const
+    {
+        // Schemas hold a handful of keys; a scan beats hashing here
+        for (size_t i = 0; i < m_fields.size(); ++i)
+        {
+            if (m_fields[i].key == key)
+                return i;
+        }
+
+        return std::nullopt;
+    }
+
+    //////////////////////////////////////////////////////
+    // PropertyColumns
+    //////////////////////////////////////////////////////
+
+    PropertyColumns::PropertyColumns(PropertySchema schema) : m_schema(std::move(schema)), m_columns(m_schema.size()) {}
+
+    PropertyColumns::PropertyColumns(PropertySchema schema, const std::span<const SharedJson> blobs) : PropertyColumns(std::move(schema))
+    {
+        reserve(blobs.size());
+
+        // Row first decoded from each tree; the span keeps the trees alive for the pass
+        std::unordered_map<const json*, size_t> decoded;
+        for (const auto& blob : blobs)
+        {
+            if (const auto [it, inserted] = decoded.try_emplace(&blob.get(), m_rows); inserted)
+                append(blob);
+            else
+                repeat_row(it->second);
+        }
+    }
+
+    void PropertyColumns::append(const json& blob)
+    {
+        for (size_t field = 0; field < m_columns.size(); ++field)
+        {
+            Column& column = m_columns[field];
+            const PropertyType type = m_schema.type(field);
+
+            const json* value = nullptr;
+            if (blob.is_object())
+            {
+                if (const auto it = blob.find(m_schema.key(field)); it != blob.end())
+                    value = &*it;
+            }
+
+            bool present = false;
+            switch (type)
+            {
+                case PropertyType::Bool:
+                    present = value != nullptr && value->is_boolean();
+                    column.bools.push_back(present && value->get<bool>() ? 1 : 0);
+                    break;
+                case PropertyType::Integer:
+                    // Unsigned values past int64_t stay in the json only
+                    present = value != nullptr && value->is_number_integer() && round_trips(type, *value);
+                    column.integers.push_back(present ? value->get<int64_t>() : 0);
+                    break;
+                case PropertyType::Number:
+                    present = value != nullptr && value->is_number();
+                    column.numbers.push_back(present ? value->get<double>() : 0.0);
+                    break;
+                case PropertyType::String:
+                    present = value != nullptr && value->is_string();
+                    column.codes.push_back(encode(column, present ? std::string_view(value->get_ref<const std::string&>()) : std::string_view()));
+                    break;
+            }
+
+            column.present.push_back(present ? 1 : 0);
+        }
+
+        ++m_rows;
+    }
+
+    void PropertyColumns::repeat_row(const size_t row)
+    {
+        for (size_t field = 0; field < m_columns.size(); ++field)
+        {
+            Column& column = m_columns[field];
+            column.present.push_back(column.present[row]);
+            switch (m_schema.type(field))
+            {
+                case PropertyType::Bool:    column.bools.push_back(column.bools[row]); break;
+                case PropertyType::Integer: column.integers.push_back(column.integers[row]); break;
+                case PropertyType::Number:  column.numbers.push_back(column.numbers[row]); break;
+                case PropertyType::String:  column.codes.push_back(column.codes[row]); break;
+            }
+        }
+
+        ++m_rows;
+    }
+
+    void PropertyColumns::reserve(const size_t count)
+    {
+        for (size_t field = 0; field < m_columns.size(); ++field)
+        {
+            Column& column = m_columns[field];
+            column.present.reserve(count);
+            switch (m_schema.type(field))
+            {
+                case PropertyType::Bool:    column.bools.reserve(count); break;
+                case PropertyType::Integer: column.integers.reserve(count); break;
+                case PropertyType::Number:  column.numbers.reserve(count); break;
+                case PropertyType::String:  column.codes.reserve(count); break;
+            }
+        }
+    }
+
+    void PropertyColumns::clear()
+    {
+        for (auto& column : m_columns)
+            column = Column();
+
+        m_rows = 0;
+    }
+
+    uint32_t PropertyColumns::encode(Column& column, const std::string_view text)
+    {
+        const size_t hash = std::hash<std::string_view>{}(text);
+        const auto [first, last] = column.codesByHash.equal_range(hash);
+        for (auto it = first; it != last; ++it)
+        {
+            if (column.dictionary[it->second] == text)
+                return it->second;
+        }
+
+        const auto code = static_cast<uint32_t>(column.dictionary.size());
+        column.dictionary.emplace_back(text);
+        column.codesByHash.emplace(hash, code);
+        return code;
+    }
+
+    const PropertyColumns::Column& PropertyColumns::column(const size_t field, const PropertyType type) const
+    {
+        if (field >= m_columns.size())
+            throw std::out_of_range("Property field " + std::to_string(field) + " is not in the schema");
+
+        if (m_schema.type(field) != type)
+            throw std::logic_error("Property '" + m_schema.key(field) + "' is read as the wrong type");
+
+        return m_columns[field];
+    }
+
+    PropertyColumns::Column& PropertyColumns::writable(const size_t field, const PropertyType type, const size_t row)
+    {
+        if (row >= m_rows)
+            throw std::out_of_range("Property row " + std::to_string(row) + " is out of range");
+
+        Column& target = const_cast<Column&>(std::as_const(*this).column(field, type));
+        target.present[row] = 1;
+        return target;
+    }
+
+    std::span<const uint8_t> PropertyColumns::bools(const size_t field) const { return column(field, PropertyType::Bool).bools; }
+    std::span<const int64_t> PropertyColumns::integers(const size_t field) const { return column(field, PropertyType::Integer).integers; }
+    std::span<const double> PropertyColumns::numbers(const size_t field) const { return column(field, PropertyType::Number).numbers; }
+    std::span<const uint32_t> PropertyColumns::string_codes(const size_t field) const { return column(field, PropertyType::String).codes; }
+
+    std::string_view PropertyColumns::string(const size_t field, const size_t row) const
+    {
+        const Column& strings = column(field, PropertyType::String);
+        return strings.dictionary[strings.codes.at(row)];
+    }
+
+    void PropertyColumns::set_bool(const size_t field, const size_t row, const bool value)
+    {
+        writable(field, PropertyType::Bool, row).bools[row] = value ? 1 : 0;
+    }
+
+    void PropertyColumns::set_integer(const size_t field, const size_t row, const int64_t value)
+    {
+        writable(field, PropertyType::Integer, row).integers[row] = value;
+    }
+
+    void PropertyColumns::set_number(const size_t field, const size_t row, const double value)
+    {
+        writable(field, PropertyType::Number, row).numbers[row] = value;
+    }
+
+    void PropertyColumns::set_string(const size_t field, const size_t row, const std::string_view value)
+    {
+        Column& strings = writable(field, PropertyType::String, row);
+        strings.codes[row] = encode(strings, value);
+    }
+
+    void PropertyColumns::erase(const size_t field, const size_t row)
+    {
+        if (field >= m_columns.size())
+            throw std::out_of_range("Property field " + std::to_string(field) + " is not in the schema");
+
+        // Back to the zero value an absent field decodes to
+        Column& target = m_columns[field];
+        target.present.at(row) = 0;
+        switch (m_schema.type(field))
+        {
+            case PropertyType::Bool:    target.bools[row] = 0; break;
+            case PropertyType::Integer: target.integers[row] = 0; break;
+            case PropertyType::Number:  target.numbers[row] = 0.0; break;
+            case PropertyType::String:  target.codes[row] = encode(target, {}); break;
+        }
+    }
+
+    bool PropertyColumns::has_values(const size_t row) const
+    {
+        for (const auto& column : m_columns)
+        {
+            if (column.present[row])
+                return true;
+        }
+
+        return false;
+    }
+
+    void PropertyColumns::write_row(const size_t row, json& blob) const
+    {
+        for (size_t field = 0; field < m_columns.size(); ++field)
+        {
+            const Column& column = m_columns[field];
+            if (!column.present[row] || blob.contains(m_schema.key(field)))
+                continue;
+
+            json& value = blob[m_schema.key(field)];
+            switch (m_schema.type(field))
+            {
+                case PropertyType::Bool:    value = column.bools[row] != 0; break;
+                case PropertyType::Integer: value = column.integers[row]; break;
+                case PropertyType::Number:  value = column.numbers[row]; break;
+                case PropertyType::String:  value = column.dictionary[column.codes[row]]; break;
+            }
+        }
+    }
+
+    void PropertyColumns::strip_row(const size_t row, json& blob) const
+    {
+        if (!blob.is_object())
+            return;
+
+        for (size_t field = 0; field < m_columns.size(); ++field)
+        {
+            if (!m_columns[field].present[row])
+                continue;
+
+            if (const auto it = blob.find(m_schema.key(field)); it != blob.end() && round_trips(m_schema.type(field), *it))
+                blob.erase(it);
+        }
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,162 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXSharedJson.cpp
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#include <edX/include/edXSharedJson.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    namespace
+    {
+        const std::shared_ptr<json>& null_value()
+        {
+            // Always referenced here, so edit() never writes to it in place
+            static const auto* instance = new std::shared_ptr<json>(std::make_shared<json>());
+            return *instance;
+        }
+    }
+
+    //////////////////////////////////////////////////////
+    // SharedJson
+    //////////////////////////////////////////////////////
+
+    SharedJson::SharedJson() : m_value(null_value()) {}
+
+    SharedJson::SharedJson(json value) : m_value(value.is_null() ? null_value() : std::make_shared<json>(std::move(value))) {}
+
+    json& SharedJson::edit()
+    {
+        if (m_value.use_count() != 1)
+            m_value = std::make_shared<json>(*m_value);
+
+        return *m_value;
+    }
+
+    //////////////////////////////////////////////////////
+    // PropertyPool
+    //////////////////////////////////////////////////////
+
+    const std::shared_ptr<json>* PropertyPool::find(const json& value, const size_t hash) const
+    {
+        const auto it = m_blobs.find(hash);
+        if (it == m_blobs.end())
+            return nullptr;
+
+        for (const auto& blob : it->second)
+        {
+            if (*blob == value)
+                return &blob;
+        }
+
+        return nullptr;
+    }
+
+    SharedJson PropertyPool::intern(json value)
+    {
+        if (value.is_null())
+            return {};
+
+        const size_t hash = std::hash<json>{}(value);
+        if (const auto* blob = find(value, hash))
+            return SharedJson(*blob);
+
+        auto blob = std::make_shared<json>(std::move(value));
+        m_blobs[hash].push_back(blob);
+        ++m_size;
+        return SharedJson(std::move(blob));
+    }
+
+    SharedJson PropertyPool::intern(const SharedJson& value)
+    {
+        if (value.is_null())
+            return {};
+
+        if (const auto it = m_byAddress.find(&value.get()); it != m_byAddress.end())
+            return it->second.second;
+
+        SharedJson shared;
+        const size_t hash = std::hash<json>{}(value.get());
+        if (const auto* blob = find(value.get(), hash))
+        {
+            shared = SharedJson(*blob);
+        }
+        else
+        {
+            // Adopt the tree itself; later edits through any handle copy it first
+            m_blobs[hash].push_back(value.m_value);
+            ++m_size;
+            shared = value;
+        }
+
+        m_byAddress.emplace(&value.get(), std::pair(value, shared));
+        return shared;
+    }
+
+    void PropertyPool::clear()
+    {
+        m_blobs.clear();
+        m_byAddress.clear();
+        m_size = 0;
+    }
+
+    //////////////////////////////////////////////////////
+    // PropertyTable
+    //////////////////////////////////////////////////////
+
+    uint32_t PropertyTable::add(const SharedJson& value)
+    {
+        if (value.is_null())
+            return NONE;
+
+        const json* address = &value.get();
+        if (const auto it = m_byAddress.find(address); it != m_byAddress.end())
+            return it->second;
+
+        auto& candidates = m_byHash[std::hash<json>{}(*address)];
+        uint32_t index = NONE;
+        for (const uint32_t candidate : candidates)
+        {
+            if (*m_entries[candidate] == *address)
+            {
+                index = candidate;
+                break;
+            }
+        }
+
+        if (index == NONE)
+        {
+            index = static_cast<uint32_t>(m_entries.size());
+            m_entries.push_back(address);
+            candidates.push_back(index);
+        }
+
+        m_byAddress.emplace(address, index);
+        return index;
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,450 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXSpatialIndex.cpp
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <utility>
+#include <edX/include/edXSpatialIndex.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    namespace
+    {
+        constexpr double DEG_TO_RAD = std::numbers::pi / 180.0;
+        constexpr double RAD_TO_DEG = 180.0 / std::numbers::pi;
+
+        // Average number of entries per cell that build() aims for
+        constexpr double TARGET_CELL_OCCUPANCY = 32.0;
+
+        double wrap_longitude(const double longitude)
+        {
+            return longitude - 360.0 * std::floor((longitude + 180.0) / 360.0);
+        }
+
+        // Rectangle enclosing a great-circle radius; whole longitude range when it covers a pole
+        GeoBounds radius_bounds(const double latitude, const double longitude, const double radiusMeters)
+        {
+            const double angle = radiusMeters / EARTH_RADIUS_METERS;
+            const double latitudeDelta = angle * RAD_TO_DEG;
+
+            GeoBounds bounds;
+            bounds.minLatitude = std::max(latitude - latitudeDelta, -90.0);
+            bounds.maxLatitude = std::min(latitude + latitudeDelta, 90.0);
+            bounds.minLongitude = -180.0;
+            bounds.maxLongitude = 180.0;
+
+            if (bounds.minLatitude <= -90.0 || bounds.maxLatitude >= 90.0)
+                return bounds;
+
+            // Widest longitude offset reached by the circle
+            const double ratio = std::sin(angle) / std::cos(latitude * DEG_TO_RAD);
+            if (angle >= std::numbers::pi / 2.0 || ratio >= 1.0)
+                return bounds;
+
+            const double longitudeDelta = std::asin(ratio) * RAD_TO_DEG;
+            bounds.minLongitude = wrap_longitude(longitude - longitudeDelta);
+            bounds.maxLongitude = wrap_longitude(longitude + longitudeDelta);
+            return bounds;
+        }
+    }
+
+    uint64_t hilbert_key(const double latitude, const double longitude)
+    {
+        // 32 bits per axis; the key packs both into 64
+        constexpr double CELLS = 4294967296.0;
+        const auto cell = [](const double unit) { return static_cast<uint64_t>(std::clamp(unit * CELLS, 0.0, CELLS - 1.0)); };
+        uint64_t x = cell((wrap_longitude(longitude) + 180.0) / 360.0);
+        uint64_t y = cell((std::clamp(latitude, -90.0, 90.0) + 90.0) / 180.0);
+
+        uint64_t key = 0;
+        for (uint64_t s = uint64_t{1} << 31; s > 0; s >>= 1)
+        {
+            const uint64_t rx = (x & s) != 0 ? 1 : 0;
+            const uint64_t ry = (y & s) != 0 ? 1 : 0;
+            key += s * s * ((3 * rx) ^ ry);
+
+            // Rotate the quadrant so the curve stays continuous; only the bits below s matter from here on
+            if (ry == 0)
+            {
+                if (rx == 1)
+                {
+                    x = s - 1 - (x & (s - 1));
+                    y = s - 1 - (y & (s - 1));
+                }
+                std::swap(x, y);
+            }
+        }
+
+        return key;
+    }
+
+    std::vector<size_t> hilbert_order(const std::vector<SceneAsset>& assets)
+    {
+        std::vector<std::pair<uint64_t, size_t>> keyed(assets.size());
+        for (size_t i = 0; i < assets.size(); ++i)
+            keyed[i] = {hilbert_key(assets[i].latitude, assets[i].longitude), i};
+
+        // Pairs compare by position on ties, which keeps the sort stable
+        std::ranges::sort(keyed);
+
+        std::vector<size_t> order(assets.size());
+        for (size_t i = 0; i < keyed.size(); ++i)
+            order[i] = keyed[i].second;
+
+        return order;
+    }
+
+    double great_circle_distance(const double latitude1, const double longitude1, const double latitude2, const double longitude2)
+    {
+        const double sinLat = std::sin((latitude2 - latitude1) * DEG_TO_RAD / 2.0);
+        const double sinLon = std::sin((longitude2 - longitude1) * DEG_TO_RAD / 2.0);
+        const double a = sinLat * sinLat + std::cos(latitude1 * DEG_TO_RAD) * std::cos(latitude2 * DEG_TO_RAD) * sinLon * sinLon;
+        return 2.0 * EARTH_RADIUS_METERS * std::asin(std::min(1.0, std::sqrt(a)));
+    }
+
+    SpatialIndex::SpatialIndex(const double cellSizeDegrees)
+    {
+        reset_grid(cellSizeDegrees);
+    }
+
+    void SpatialIndex::reset_grid(const double cellSize)
+    {
+        m_cellSize = std::clamp(cellSize, 1e-5, 90.0);
+        m_rows = static_cast<int64_t>(std::ceil(180.0 / m_cellSize));
+        m_columns = static_cast<int64_t>(std::ceil(360.0 / m_cellSize));
+        m_cells.clear();
+        m_cellOfKey.clear();
+        m_size = 0;
+    }
+
+    void SpatialIndex::clear()
+    {
+        m_cells.clear();
+        m_cellOfKey.clear();
+        m_size = 0;
+    }
+
+    int64_t SpatialIndex::row_of(const double latitude) const
+    {
+        return std::clamp(static_cast<int64_t>(std::floor((latitude + 90.0) / m_cellSize)), int64_t(0), m_rows - 1);
+    }
+
+    int64_t SpatialIndex::column_of(const double longitude) const
+    {
+        return std::clamp(static_cast<int64_t>(std::floor((wrap_longitude(longitude) + 180.0) / m_cellSize)), int64_t(0), m_columns - 1);
+    }
+
+    uint64_t SpatialIndex::cell_of(const double latitude, const double longitude) const
+    {
+        return static_cast<uint64_t>(row_of(latitude) * m_columns + column_of(longitude));
+    }
+
+    void SpatialIndex::build(const std::vector<SceneAsset>& assets)
+    {
+        std::vector<double> latitudes(assets.size()), longitudes(assets.size());
+        for (size_t i = 0; i < assets.size(); ++i)
+        {
+            latitudes[i] = assets[i].latitude;
+            longitudes[i] = assets[i].longitude;
+        }
+
+        bulk_build(assets.size(), latitudes.data(), longitudes.data());
+    }
+
+    void SpatialIndex::build(const AssetStore& store)
+    {
+        bulk_build(store.size(), store.latitudes().data(), store.longitudes().data());
+    }
+
+    void SpatialIndex::bulk_build(const size_t count, const double* latitudes, const double* longitudes)
+    {
+        double cellSize = m_cellSize;
+        if (count > 0)
+        {
+            const auto [minLat, maxLat] = std::minmax_element(latitudes, latitudes + count);
+            const auto [minLon, maxLon] = std::minmax_element(longitudes, longitudes + count);
+            const double area = (*maxLat - *minLat) * (*maxLon - *minLon);
+            if (area > 0.0)
+                cellSize = std::clamp(std::sqrt(area * TARGET_CELL_OCCUPANCY / static_cast<double>(count)), 1e-4, 10.0);
+        }
+
+        reset_grid(cellSize);
+        m_cellOfKey.resize(count);
+
+        // Consecutive assets often share a cell; skip the hash lookup for them
+        uint64_t lastCell = NO_CELL;
+        std::vector<Entry>* lastEntries = nullptr;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint64_t cell = cell_of(latitudes[i], longitudes[i]);
+            if (cell != lastCell)
+            {
+                lastCell = cell;
+                lastEntries = &m_cells[cell];
+            }
+
+            lastEntries->push_back({i, latitudes[i], longitudes[i]});
+            m_cellOfKey[i] = cell;
+        }
+
+        m_size = count;
+    }
+
+    bool SpatialIndex::contains(const size_t key) const
+    {
+        return key < m_cellOfKey.size() && m_cellOfKey[key] != NO_CELL;
+    }
+
+    SpatialIndex::Entry* SpatialIndex::find_entry(const size_t key)
+    {
+        if (!contains(key))
+            return nullptr;
+
+        auto& entries = m_cells[m_cellOfKey[key]];
+        const auto it = std::ranges::find(entries, key, &Entry::key);
+        return it != entries.end() ? &*it : nullptr;
+    }
+
+    void SpatialIndex::insert(const size_t key, const double latitude, const double longitude)
+    {
+        if (contains(key))
+            erase(key);
+
+        if (key >= m_cellOfKey.size())
+            m_cellOfKey.resize(key + 1, NO_CELL);
+
+        const uint64_t cell = cell_of(latitude, longitude);
+        m_cells[cell].push_back({key, latitude, longitude});
+        m_cellOfKey[key] = cell;
+        ++m_size;
+    }
+
+    bool SpatialIndex::erase(const size_t key)
+    {
+        if (!contains(key))
+            return false;
+
+        const auto cell = m_cells.find(m_cellOfKey[key]);
+        auto& entries = cell->second;
+        const auto it = std::ranges::find(entries, key, &Entry::key);
+        *it = entries.back();
+        entries.pop_back();
+        if (entries.empty())
+            m_cells.erase(cell);
+
+        m_cellOfKey[key] = NO_CELL;
+        --m_size;
+        return true;
+    }
+
+    bool SpatialIndex::move(const size_t key, const double latitude, const double longitude)
+    {
+        Entry* entry = find_entry(key);
+        if (entry == nullptr)
+            return false;
+
+        // Moves within a cell only update the stored position
+        if (cell_of(latitude, longitude) == m_cellOfKey[key])
+        {
+            entry->latitude = latitude;
+            entry->longitude = longitude;
+            return true;
+        }
+
+        erase(key);
+        insert(key, latitude, longitude);
+        return true;
+    }
+
+    bool SpatialIndex::rekey(const size_t from, const size_t to)
+    {
+        if (from == to)
+            return contains(from);
+
+        if (contains(to))
+            return false;
+
+        Entry* entry = find_entry(from);
+        if (entry == nullptr)
+            return false;
+
+        if (to >= m_cellOfKey.size())
+            m_cellOfKey.resize(to + 1, NO_CELL);
+
+        entry->key = to;
+        m_cellOfKey[to] = m_cellOfKey[from];
+        m_cellOfKey[from] = NO_CELL;
+        return true;
+    }
+
+    template<typename Visitor>
+    void SpatialIndex::visit_cells(const GeoBounds& bounds, Visitor&& visitor) const
+    {
+        if (bounds.is_empty() || m_cells.empty())
+            return;
+
+        // Range ends are clamped rather than wrapped so that 180 maps to the last column
+        auto column_bound = [this](const double longitude)
+        {
+            return std::clamp(static_cast<int64_t>(std::floor((std::clamp(longitude, -180.0, 180.0) + 180.0) / m_cellSize)), int64_t(0), m_columns - 1);
+        };
+
+        std::pair<int64_t, int64_t> columns[2];
+        size_t rangeCount = 1;
+        if (bounds.maxLongitude - bounds.minLongitude >= 360.0)
+            columns[0] = {0, m_columns - 1};
+        else if (bounds.minLongitude > bounds.maxLongitude)
+        {
+            columns[0] = {column_bound(bounds.minLongitude), m_columns - 1};
+            columns[1] = {0, column_bound(bounds.maxLongitude)};
+            rangeCount = 2;
+        }
+        else
+            columns[0] = {column_bound(bounds.minLongitude), column_bound(bounds.maxLongitude)};
+
+        const int64_t firstRow = row_of(bounds.minLatitude);
+        const int64_t lastRow = row_of(bounds.maxLatitude);
+
+        double cellCount = 0.0;
+        for (size_t r = 0; r < rangeCount; ++r)
+            cellCount += static_cast<double>(columns[r].second - columns[r].first + 1);
+        cellCount *= static_cast<double>(lastRow - firstRow + 1);
+
+        // Large areas have more cells than are occupied; walk the occupied ones instead
+        if (cellCount > static_cast<double>(m_cells.size()))
+        {
+            for (const auto& [cell, entries] : m_cells)
+            {
+                const int64_t row = static_cast<int64_t>(cell) / m_columns;
+                const int64_t column = static_cast<int64_t>(cell) % m_columns;
+                if (row < firstRow || row > lastRow)
+                    continue;
+
+                for (size_t r = 0; r < rangeCount; ++r)
+                {
+                    if (column >= columns[r].first && column <= columns[r].second)
+                    {
+                        visitor(entries);
+                        break;
+                    }
+                }
+            }
+            return;
+        }
+
+        for (int64_t row = firstRow; row <= lastRow; ++row)
+        {
+            for (size_t r = 0; r < rangeCount; ++r)
+            {
+                for (int64_t column = columns[r].first; column <= columns[r].second; ++column)
+                {
+                    if (const auto it = m_cells.find(static_cast<uint64_t>(row * m_columns + column)); it != m_cells.end())
+                        visitor(it->second);
+                }
+            }
+        }
+    }
+
+    std::vector<size_t> SpatialIndex::query_rect(const GeoBounds& bounds) const
+    {
+        std::vector<size_t> result;
+        visit_cells(bounds, [&](const std::vector<Entry>& entries)
+        {
+            for (const auto& entry : entries)
+            {
+                if (bounds.contains(entry.latitude, entry.longitude))
+                    result.push_back(entry.key);
+            }
+        });
+
+        return result;
+    }
+
+    std::vector<size_t> SpatialIndex::query_radius(const double latitude, const double longitude, const double radiusMeters) const
+    {
+        std::vector<size_t> result;
+        if (radiusMeters < 0.0)
+            return result;
+
+        visit_cells(radius_bounds(latitude, longitude, radiusMeters), [&](const std::vector<Entry>& entries)
+        {
+            for (const auto& entry : entries)
+            {
+                if (great_circle_distance(latitude, longitude, entry.latitude, entry.longitude) <= radiusMeters)
+                    result.push_back(entry.key);
+            }
+        });
+
+        return result;
+    }
+
+    std::vector<size_t> SpatialIndex::nearest(const double latitude, const double longitude, size_t k) const
+    {
+        std::vector<size_t> result;
+        k = std::min(k, m_size);
+        if (k == 0)
+            return result;
+
+        // Start with the radius expected to hold k entries and double until it does
+        constexpr double HALF_CIRCUMFERENCE = std::numbers::pi * EARTH_RADIUS_METERS;
+        const double cellMeters = m_cellSize * DEG_TO_RAD * EARTH_RADIUS_METERS;
+        double radius = cellMeters * std::max(1.0, std::sqrt(static_cast<double>(k) / TARGET_CELL_OCCUPANCY));
+
+        std::vector<std::pair<double, size_t>> candidates;
+        while (true)
+        {
+            candidates.clear();
+            visit_cells(radius_bounds(latitude, longitude, radius), [&](const std::vector<Entry>& entries)
+            {
+                for (const auto& entry : entries)
+                {
+                    const double distance = great_circle_distance(latitude, longitude, entry.latitude, entry.longitude);
+                    if (distance <= radius)
+                        candidates.emplace_back(distance, entry.key);
+                }
+            });
+
+            if (candidates.size() >= k || radius >= HALF_CIRCUMFERENCE)
+                break;
+
+            radius *= 2.0;
+        }
+
+        k = std::min(k, candidates.size());
+        std::partial_sort(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(k), candidates.end());
+
+        result.reserve(k);
+        for (size_t i = 0; i < k; ++i)
+            result.push_back(candidates[i].second);
+
+        return result;
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
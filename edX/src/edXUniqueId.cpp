@@ -0,0 +1,178 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* Mozilla Public License Version 2.0
+* -------------------------------------------------------
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+* -------------------------------------------------------
+* edXUniqueId.cpp
+* -------------------------------------------------------
+* Created: 16/10/2026
+* -------------------------------------------------------
+*/
+#include <atomic>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <edX/include/edXUniqueId.h>
+
+/// ----------------------------------------------------------------------------
+
+namespace edx
+{
+    namespace
+    {
+        constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+        // Text of a non-hex id; shared by its copies and freed with the last one
+        struct IdText
+        {
+            mutable std::atomic<size_t> references;
+            size_t hash;
+            std::string text;
+        };
+
+        static_assert(sizeof(const IdText*) <= sizeof(uint64_t), "text block pointers must fit the id");
+
+        int hex_digit(const char c)
+        {
+            if (c >= '0' && c <= '9')
+                return c - '0';
+
+            if (c >= 'a' && c <= 'f')
+                return c - 'a' + 10;
+
+            return -1;
+        }
+
+        // Packed form of lowercase hex text of 1 to 15 digits, nullopt for any other text
+        std::optional<uint64_t> pack_hex(const std::string_view text, const int lengthShift)
+        {
+            if (text.empty() || text.size() >= 16)
+                return std::nullopt;
+
+            uint64_t value = 0;
+            for (const char c : text)
+            {
+                const int digit = hex_digit(c);
+                if (digit < 0)
+                    return std::nullopt;
+
+                value = value << 4 | static_cast<uint64_t>(digit);
+            }
+
+            return static_cast<uint64_t>(text.size()) << lengthShift | value;
+        }
+
+        const IdText& text_block(const uint64_t bits)
+        {
+            return *reinterpret_cast<const IdText*>(static_cast<uintptr_t>(bits));
+        }
+    }
+
+    UniqueId::UniqueId(const std::string_view text)
+    {
+        if (text.empty())
+            return;
+
+        if (const auto packed = pack_hex(text, LENGTH_SHIFT))
+        {
+            m_bits = *packed;
+            return;
+        }
+
+        // Uppercase, long or non-hex ids keep their exact text
+        auto* block = new IdText{1, std::hash<std::string_view>{}(text), std::string(text)};
+        const uint64_t pointer = reinterpret_cast<uintptr_t>(block);
+        if (pointer > VALUE_MASK)
+        {
+            delete block;
+            throw std::runtime_error("Unique id text address does not fit a unique id");
+        }
+
+        m_bits = pointer;
+    }
+
+    UniqueId UniqueId::generate()
+    {
+        thread_local std::mt19937 gen(std::random_device{}());
+        return from_hex32(static_cast<uint32_t>(gen()));
+    }
+
+    UniqueId UniqueId::from_hex32(const uint32_t value)
+    {
+        UniqueId id;
+        id.m_bits = uint64_t{8} << LENGTH_SHIFT | value;
+        return id;
+    }
+
+    std::string UniqueId::str() const
+    {
+        if (m_bits == 0)
+            return {};
+
+        if (!is_hex())
+            return text_block(m_bits).text;
+
+        const size_t length = m_bits >> LENGTH_SHIFT;
+        std::string text(length, '0');
+        uint64_t value = m_bits & VALUE_MASK;
+        for (size_t i = length; i-- > 0; value >>= 4)
+            text[i] = HEX_DIGITS[value & 0xF];
+
+        return text;
+    }
+
+    void UniqueId::retain() const noexcept
+    {
+        text_block(m_bits).references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void UniqueId::release() noexcept
+    {
+        const IdText& block = text_block(m_bits);
+        if (block.references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete &block;
+
+        m_bits = 0;
+    }
+
+    size_t UniqueId::text_hash() const noexcept
+    {
+        return text_block(m_bits).hash;
+    }
+
+    bool UniqueId::equals(const std::string_view text) const
+    {
+        if (text.empty())
+            return m_bits == 0;
+
+        if (const auto packed = pack_hex(text, LENGTH_SHIFT))
+            return m_bits == *packed;
+
+        return is_text() && text_block(m_bits).text == text;
+    }
+
+    bool UniqueId::same_text(const UniqueId& a, const UniqueId& b)
+    {
+        const IdText& x = text_block(a.m_bits);
+        const IdText& y = text_block(b.m_bits);
+        return x.hash == y.hash && x.text == y.text;
+    }
+
+} // namespace edx
+
+/// ----------------------------------------------------------------------------
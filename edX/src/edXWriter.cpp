@@ -122,7 +122,7 @@ void writeEdxFile(const std::string &filename,
     {
         file << asset.id << "=" << asset.uniqueId << ", " << asset.groupId << ", " << asset.latitude << ", "
              << asset.longitude << ", " << asset.heading << ", " << asset.altitude << ", " << asset.locked << ", "
-             << asset.hidden << ", " << asset.otherProperties.dump() << "\n";
+             << asset.hidden << ", " << asset.otherProperties->dump() << "\n";
     }
 
     file.close();
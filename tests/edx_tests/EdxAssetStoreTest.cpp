@@ -0,0 +1,682 @@
+﻿/**
+* -------------------------------------------------------
+* Scenery Editor X - edX Asset Store Tests
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+* Copyright (c) 2025 Coalition of Freeware Developers
+* -------------------------------------------------------
+* EdxAssetStoreTest.cpp
+* -------------------------------------------------------
+* Tests for the structure-of-arrays asset store, its kernels and the spatial index
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <edX/config/edXConfig.h>
+#include <edX/include/edXAssetStore.h>
+#include <edX/include/edXLibraryFile.h>
+#include <edX/include/edXSpatialIndex.h>
+
+/// -------------------------------------------------------
+
+using namespace edx;
+using Catch::Approx;
+
+namespace EdxTests
+{
+namespace AssetStoreTests
+{
+// Assets on a regular grid around KSEA; odd counts exercise the scalar tails
+inline std::vector<SceneAsset> CreateGridAssets(int rows, int columns)
+{
+    std::vector<SceneAsset> assets;
+    for (int r = 0; r < rows; ++r)
+    {
+        for (int c = 0; c < columns; ++c)
+        {
+            SceneAsset asset;
+            asset.id = "asset_" + std::to_string(r) + "_" + std::to_string(c);
+            asset.uniqueId = std::to_string(r * columns + c);
+            asset.latitude = 47.0 + r * 0.01;
+            asset.longitude = -122.0 + c * 0.01;
+            asset.altitude = r + c;
+            asset.heading = (r * 37 + c * 11) % 360;
+            asset.layerId = r % 2 ? "odd" : "even";
+            asset.hidden = c == 0;
+            asset.otherProperties["row"] = r;
+            assets.push_back(asset);
+        }
+    }
+    return assets;
+}
+} // namespace AssetStoreTests
+} // namespace EdxTests
+
+/// -------------------------------------------------------
+
+TEST_CASE("Asset store conversion", "[assets][store]")
+{
+    using namespace EdxTests::AssetStoreTests;
+
+    auto assets = CreateGridAssets(7, 9);
+
+    SECTION("Round trip keeps every field")
+    {
+        AssetStore store(assets);
+        REQUIRE(store.size() == assets.size());
+        REQUIRE(store.latitudes()[10] == assets[10].latitude);
+        REQUIRE((store.flags()[0] & AssetStore::Hidden) != 0);
+
+        auto restored = store.to_assets();
+        REQUIRE(restored.size() == assets.size());
+        for (size_t i = 0; i < assets.size(); ++i)
+        {
+            json expected, actual;
+            assets[i].to_json(expected);
+            restored[i].to_json(actual);
+            REQUIRE(actual == expected);
+            REQUIRE(restored[i].hidden == assets[i].hidden);
+        }
+    }
+
+    SECTION("Moving in and writing positions back")
+    {
+        auto copy = assets;
+        AssetStore store(std::move(copy));
+        REQUIRE(store.ids()[5] == assets[5].id);
+        REQUIRE(store.properties()[20]["row"] == 2);
+
+        store.altitudes()[3] = 1234.0;
+        store.write_positions(assets);
+        REQUIRE(assets[3].altitude == 1234.0);
+    }
+}
+
+TEST_CASE("Asset store kernels", "[assets][store][kernels]")
+{
+    using namespace EdxTests::AssetStoreTests;
+
+    auto assets = CreateGridAssets(11, 13);
+    AssetStore store(assets);
+
+    SECTION("Bounds")
+    {
+        REQUIRE(compute_bounds(AssetStore()).is_empty());
+
+        GeoBounds bounds = compute_bounds(store);
+        REQUIRE(bounds.minLatitude == Approx(47.0));
+        REQUIRE(bounds.maxLatitude == Approx(47.1));
+        REQUIRE(bounds.minLongitude == Approx(-122.0));
+        REQUIRE(bounds.maxLongitude == Approx(-121.88));
+        REQUIRE(bounds.minAltitude == 0.0);
+        REQUIRE(bounds.maxAltitude == 22.0);
+    }
+
+    SECTION("Range filter matches a scalar scan")
+    {
+        GeoBounds window;
+        window.minLatitude = 47.025;
+        window.maxLatitude = 47.065;
+        window.minLongitude = -121.955;
+        window.maxLongitude = -121.905;
+
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < assets.size(); ++i)
+        {
+            if (window.contains(assets[i].latitude, assets[i].longitude))
+                expected.push_back(i);
+        }
+
+        REQUIRE(expected.size() == 4 * 5);
+        REQUIRE(filter_in_bounds(store, window) == expected);
+        REQUIRE(filter_in_bounds(store, GeoBounds()).empty());
+    }
+
+    SECTION("Rectangles across the antimeridian")
+    {
+        AssetStore pacific;
+        for (double lon : {179.5, -179.5, 0.0, 170.0, -170.0})
+        {
+            SceneAsset asset;
+            asset.longitude = lon;
+            pacific.push_back(asset);
+        }
+
+        GeoBounds window;
+        window.minLatitude = -1.0;
+        window.maxLatitude = 1.0;
+        window.minLongitude = 179.0;
+        window.maxLongitude = -179.0;
+        REQUIRE(filter_in_bounds(pacific, window) == std::vector<size_t>{0, 1});
+    }
+
+    SECTION("Transforms")
+    {
+        translate_positions(store, 0.5, 1.0, 10.0);
+        REQUIRE(store.latitudes()[0] == Approx(47.5));
+        REQUIRE(store.longitudes()[0] == Approx(-121.0));
+        REQUIRE(store.altitudes()[0] == Approx(10.0));
+
+        // Crossing the antimeridian wraps; passing a pole clamps
+        translate_positions(store, 50.0, 300.0);
+        for (size_t i = 0; i < store.size(); ++i)
+        {
+            REQUIRE(store.latitudes()[i] == 90.0);
+            REQUIRE(store.longitudes()[i] >= -180.0);
+            REQUIRE(store.longitudes()[i] < 180.0);
+        }
+        REQUIRE(store.longitudes()[0] == Approx(179.0));
+
+        rotate_headings(store, -450.0);
+        for (size_t i = 0; i < store.size(); ++i)
+        {
+            REQUIRE(store.headings()[i] >= 0.0);
+            REQUIRE(store.headings()[i] < 360.0);
+            REQUIRE(store.headings()[i] == Approx(std::fmod(assets[i].heading + 270.0, 360.0)));
+        }
+
+        AssetStore scaled(assets);
+        scale_positions(scaled, 47.0, -122.0, 2.0);
+        REQUIRE(scaled.latitudes().back() == Approx(47.2));
+        REQUIRE(scaled.longitudes().back() == Approx(-121.76));
+
+        // Offsets across the antimeridian go the short way; results wrap and clamp
+        std::vector<SceneAsset> pacific(3);
+        pacific[0].latitude = 10.0;
+        pacific[0].longitude = -179.9;
+        pacific[1].latitude = 80.0;
+        pacific[1].longitude = 179.8;
+        pacific[2].latitude = 0.0;
+        pacific[2].longitude = -179.5;
+        AssetStore dateline(pacific);
+        scale_positions(dateline, 45.0, 179.9, 2.0);
+        REQUIRE(dateline.longitudes()[0] == Approx(-179.7));
+        REQUIRE(dateline.longitudes()[1] == Approx(179.7));
+        REQUIRE(dateline.longitudes()[2] == Approx(-178.9));
+        REQUIRE(dateline.latitudes()[1] == 90.0);
+        REQUIRE(dateline.latitudes()[2] == Approx(-45.0));
+
+        scale_positions(dateline, 0.0, 179.9, 10.0);
+        for (size_t i = 0; i < dateline.size(); ++i)
+        {
+            REQUIRE(dateline.longitudes()[i] >= -180.0);
+            REQUIRE(dateline.longitudes()[i] < 180.0);
+        }
+    }
+}
+
+TEST_CASE("Spatial index queries", "[assets][spatial]")
+{
+    using namespace EdxTests::AssetStoreTests;
+
+    auto assets = CreateGridAssets(40, 50);
+    SpatialIndex index;
+    index.build(assets);
+    REQUIRE(index.size() == assets.size());
+
+    auto brute_force_radius = [&](double lat, double lon, double radius)
+    {
+        std::vector<size_t> keys;
+        for (size_t i = 0; i < assets.size(); ++i)
+        {
+            if (great_circle_distance(lat, lon, assets[i].latitude, assets[i].longitude) <= radius)
+                keys.push_back(i);
+        }
+        return keys;
+    };
+
+    auto sorted = [](std::vector<size_t> keys)
+    {
+        std::ranges::sort(keys);
+        return keys;
+    };
+
+    SECTION("Great-circle distance")
+    {
+        REQUIRE(great_circle_distance(0.0, 0.0, 0.0, 1.0) == Approx(111195.0).epsilon(0.001));
+        REQUIRE(great_circle_distance(47.0, 179.9, 47.0, -179.9) == Approx(great_circle_distance(47.0, 0.0, 47.0, 0.2)));
+    }
+
+    SECTION("Rectangle and radius match a full scan")
+    {
+        GeoBounds window;
+        window.minLatitude = 47.105;
+        window.maxLatitude = 47.205;
+        window.minLongitude = -121.805;
+        window.maxLongitude = -121.655;
+
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < assets.size(); ++i)
+        {
+            if (window.contains(assets[i].latitude, assets[i].longitude))
+                expected.push_back(i);
+        }
+        REQUIRE(expected.size() == 10 * 15);
+        REQUIRE(sorted(index.query_rect(window)) == expected);
+
+        for (double radius : {0.0, 500.0, 5000.0, 50000.0})
+            REQUIRE(sorted(index.query_radius(47.2, -121.75, radius)) == brute_force_radius(47.2, -121.75, radius));
+    }
+
+    SECTION("Nearest neighbours")
+    {
+        auto nearest = index.nearest(47.1, -121.8, 5);
+        REQUIRE(nearest.size() == 5);
+        REQUIRE(assets[nearest[0]].id == "asset_10_20");
+        for (size_t i = 1; i < nearest.size(); ++i)
+        {
+            REQUIRE(great_circle_distance(47.1, -121.8, assets[nearest[i - 1]].latitude, assets[nearest[i - 1]].longitude) <=
+                    great_circle_distance(47.1, -121.8, assets[nearest[i]].latitude, assets[nearest[i]].longitude));
+        }
+
+        // Far from every asset and asking for more than exist
+        REQUIRE(index.nearest(-40.0, 100.0, 1).size() == 1);
+        REQUIRE(index.nearest(0.0, 0.0, assets.size() + 10).size() == assets.size());
+    }
+
+    SECTION("Incremental updates")
+    {
+        const size_t last = assets.size() - 1;
+
+        // Erase-by-swap as done by EdxProject::erase_asset
+        REQUIRE(index.erase(0));
+        REQUIRE(index.rekey(last, 0));
+        REQUIRE_FALSE(index.contains(last));
+        REQUIRE(index.nearest(assets[last].latitude, assets[last].longitude, 1) == std::vector<size_t>{0});
+
+        REQUIRE(index.move(5, -33.9, 151.2));
+        REQUIRE(index.query_radius(-33.9, 151.2, 10.0) == std::vector<size_t>{5});
+
+        index.insert(last, 0.0, 179.99);
+        GeoBounds pacific;
+        pacific.minLatitude = -1.0;
+        pacific.maxLatitude = 1.0;
+        pacific.minLongitude = 179.9;
+        pacific.maxLongitude = -179.9;
+        REQUIRE(index.query_rect(pacific) == std::vector<size_t>{last});
+        REQUIRE(index.query_radius(0.0, -179.99, 5000.0) == std::vector<size_t>{last});
+        REQUIRE(index.size() == assets.size());
+
+        REQUIRE_FALSE(index.erase(assets.size() + 100));
+    }
+
+    SECTION("Built from an asset store")
+    {
+        SpatialIndex fromStore;
+        fromStore.build(AssetStore(assets));
+        REQUIRE(sorted(fromStore.query_radius(47.2, -121.75, 3000.0)) == brute_force_radius(47.2, -121.75, 3000.0));
+    }
+}
+
+TEST_CASE("Typed property columns", "[assets][store][properties]")
+{
+    using namespace EdxTests::AssetStoreTests;
+
+    auto assets = CreateGridAssets(7, 9);
+    for (size_t i = 0; i < assets.size(); ++i)
+    {
+        assets[i].otherProperties["scale"] = 0.5 + static_cast<double>(i % 4);
+        assets[i].otherProperties["Building_Type"] = i % 3 == 0 ? "Hangar" : "Terminal";
+    }
+    assets[2].otherProperties["row"] = "not a number";
+    assets[3].otherProperties = json();
+
+    PropertySchema schema;
+    const size_t row = schema.add("row", PropertyType::Integer);
+    const size_t scale = schema.add("scale", PropertyType::Number);
+    const size_t type = schema.add("Building_Type", PropertyType::String);
+    const size_t missing = schema.add("night_lit", PropertyType::Bool);
+    REQUIRE(schema.add("scale", PropertyType::Number) == scale);
+    REQUIRE_THROWS(schema.add("scale", PropertyType::String));
+    REQUIRE(schema.find("Building_Type") == type);
+    REQUIRE_FALSE(schema.find("unknown").has_value());
+
+    SECTION("Columns match the json values")
+    {
+        AssetStore store(assets);
+        store.promote_properties(schema);
+        const PropertyColumns& columns = store.property_columns();
+        REQUIRE(columns.size() == assets.size());
+
+        for (size_t i = 0; i < assets.size(); ++i)
+        {
+            const json& properties = assets[i].otherProperties;
+            const bool hasRow = properties.contains("row") && properties["row"].is_number_integer();
+            REQUIRE(columns.present(row)[i] == (hasRow ? 1 : 0));
+            if (hasRow)
+                REQUIRE(columns.integers(row)[i] == properties["row"].get<int64_t>());
+
+            REQUIRE(columns.present(scale)[i] == (properties.contains("scale") ? 1 : 0));
+            if (properties.contains("scale"))
+                REQUIRE(columns.numbers(scale)[i] == properties["scale"].get<double>());
+
+            REQUIRE(columns.present(missing)[i] == 0);
+        }
+
+        REQUIRE_THROWS_AS(columns.numbers(row), std::logic_error);
+        REQUIRE(columns.string(type, 0) == "Hangar");
+        REQUIRE(columns.string(type, 1) == "Terminal");
+        REQUIRE(columns.string_codes(type)[6] == columns.string_codes(type)[0]);
+    }
+
+    SECTION("Filtering matches a json scan")
+    {
+        AssetStore store(assets);
+        store.promote_properties(schema);
+
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < assets.size(); ++i)
+        {
+            const json& properties = assets[i].otherProperties;
+            if (properties.contains("scale") && properties["scale"].get<double>() > 2.0 && properties["Building_Type"] == "Hangar")
+                expected.push_back(i);
+        }
+
+        std::vector<size_t> large = store.property_columns().filter<double>(scale, [](double value) { return value > 2.0; });
+        std::vector<size_t> hangars = store.property_columns().filter<std::string_view>(type, [](std::string_view value) { return value == "Hangar"; });
+        std::vector<size_t> both;
+        std::ranges::set_intersection(large, hangars, std::back_inserter(both));
+        REQUIRE_FALSE(expected.empty());
+        REQUIRE(both == expected);
+    }
+
+    SECTION("Promoted values live only in the columns")
+    {
+        assets[1].otherProperties = assets[0].otherProperties;
+        assets[4].otherProperties["scale"] = 7;
+
+        AssetStore store(assets);
+        store.promote_properties(schema);
+        REQUIRE_FALSE(store.properties()[0]->contains("scale"));
+        REQUIRE_FALSE(store.properties()[0]->contains("Building_Type"));
+        REQUIRE(store.properties()[0].shares_with(store.properties()[1]));
+        REQUIRE(store.properties()[2]["row"] == "not a number");
+
+        // An integer in a Number field stays exact in the json
+        REQUIRE(store.properties()[4]["scale"].is_number_integer());
+
+        std::vector<SceneAsset> restored = store.to_assets();
+        for (size_t i = 0; i < assets.size(); ++i)
+            REQUIRE(restored[i].otherProperties.get().dump() == assets[i].otherProperties.get().dump());
+        REQUIRE(restored[0].otherProperties.shares_with(restored[1].otherProperties));
+        REQUIRE(store.full_properties(5) == assets[5].otherProperties);
+
+        store.set_property_number(5, scale, 9.25);
+        store.set_property_integer(2, row, 7);
+        store.set_property_string(0, type, "Hangar 2");
+        store.set_property_bool(6, missing, true);
+        store.erase_property(4, scale);
+        REQUIRE_THROWS_AS(store.set_property_string(0, scale, "wide"), std::logic_error);
+        REQUIRE_THROWS_AS(store.set_property_bool(assets.size(), missing, true), std::out_of_range);
+
+        REQUIRE(store.property_columns().numbers(scale)[5] == 9.25);
+        REQUIRE(store.property_columns().string(type, 0) == "Hangar 2");
+        REQUIRE(store.property_columns().string(type, 1) == "Hangar");
+        REQUIRE_FALSE(store.properties()[2]->contains("row"));
+
+        restored = store.to_assets();
+        REQUIRE(restored[5].otherProperties["scale"] == 9.25);
+        REQUIRE(restored[2].otherProperties["row"] == 7);
+        REQUIRE(restored[0].otherProperties["Building_Type"] == "Hangar 2");
+        REQUIRE(restored[1].otherProperties["Building_Type"] == "Hangar");
+        REQUIRE(restored[6].otherProperties["night_lit"] == true);
+        REQUIRE_FALSE(restored[4].otherProperties->contains("scale"));
+
+        // Dropping the schema puts the values back into the blobs
+        store.promote_properties(PropertySchema());
+        REQUIRE(store.property_columns().size() == 0);
+        REQUIRE(store.properties()[5]["scale"] == 9.25);
+        REQUIRE(store.properties()[6]["night_lit"] == true);
+    }
+
+    SECTION("Integers past int64_t stay in the json")
+    {
+        const std::vector<SharedJson> blobs{json{{"row", std::numeric_limits<uint64_t>::max()}}, json{{"row", uint64_t{5}}}};
+        PropertyColumns columns(schema, blobs);
+        REQUIRE(columns.present(row)[0] == 0);
+        REQUIRE(columns.present(row)[1] == 1);
+        REQUIRE(columns.integers(row)[1] == 5);
+        REQUIRE(columns.filter<int64_t>(row, [](int64_t value) { return value < 0; }).empty());
+
+        json stripped = blobs[0].get();
+        columns.strip_row(0, stripped);
+        REQUIRE(stripped == blobs[0].get());
+    }
+
+    SECTION("Property strings stay out of the intern pool")
+    {
+        const size_t pooled = InternedString::pool_size();
+        std::vector<SharedJson> blobs;
+        for (int i = 0; i < 100; ++i)
+            blobs.emplace_back(json{{"Building_Type", "distinct_" + std::to_string(i)}});
+
+        PropertyColumns columns(schema, blobs);
+        REQUIRE(columns.string(type, 42) == "distinct_42");
+        REQUIRE(InternedString::pool_size() == pooled);
+    }
+
+    SECTION("Columns follow the store and library objects")
+    {
+        AssetStore store;
+        store.promote_properties(schema);
+        for (const auto& asset : assets)
+            store.push_back(asset);
+        REQUIRE(store.property_columns().size() == assets.size());
+        REQUIRE(store.property_columns().integers(row)[10] == 1);
+
+        store.clear();
+        REQUIRE(store.property_columns().size() == 0);
+        REQUIRE(store.property_columns().schema().size() == schema.size());
+
+        LibraryFile library;
+        for (int i = 0; i < 3; ++i)
+        {
+            LibraryObject obj;
+            obj.id = "object_" + std::to_string(i);
+            obj.uniqueId = std::to_string(i);
+            obj.properties["scale"] = i;
+            library.objects.push_back(obj);
+        }
+
+        PropertyColumns columns = library.property_columns(schema);
+        REQUIRE(columns.size() == 3);
+        REQUIRE(columns.numbers(scale)[2] == 2.0);
+        REQUIRE(columns.present(row)[0] == 0);
+    }
+}
+
+TEST_CASE("Group transforms", "[assets][store][transform]")
+{
+    using namespace EdxTests::AssetStoreTests;
+
+    auto assets = CreateGridAssets(9, 11);
+    AssetStore store(assets);
+
+    SECTION("Selections")
+    {
+        const auto odd = select_layer(store, "odd");
+        REQUIRE(odd.size() == 4 * 11);
+        REQUIRE(std::ranges::all_of(odd, [&](size_t i) { return assets[i].layerId == "odd"; }));
+
+        const std::vector<std::string> ids = {"asset_2_3", "asset_0_0", "missing"};
+        REQUIRE(select_ids(store, ids) == std::vector<size_t>{0, 2 * 11 + 3});
+        REQUIRE(select_flagged(store, AssetStore::Hidden).size() == 9);
+        REQUIRE(select_group(store, "none").empty());
+    }
+
+    SECTION("Translate in metres keeps the group rigid")
+    {
+        const auto odd = select_layer(store, "odd");
+        translate_metres(store, odd, 300.0, 400.0, 2.0);
+
+        for (size_t i = 0; i < assets.size(); ++i)
+        {
+            const double moved = great_circle_distance(assets[i].latitude, assets[i].longitude, store.latitudes()[i], store.longitudes()[i]);
+            if (assets[i].layerId == "odd")
+            {
+                REQUIRE(moved == Approx(500.0).epsilon(0.005));
+                REQUIRE(store.altitudes()[i] == assets[i].altitude + 2.0);
+            }
+            else
+            {
+                REQUIRE(moved == 0.0);
+            }
+        }
+
+        REQUIRE_THROWS_AS(translate_metres(store, std::vector<size_t>{assets.size()}, 1.0, 1.0), std::out_of_range);
+        REQUIRE_THROWS_AS(translate_metres(store, std::vector<size_t>{0, 2, 2}, 1.0, 1.0), std::invalid_argument);
+        REQUIRE_THROWS_AS(rotate_about(store, std::vector<size_t>{3, 1}, 0.0, 0.0, 90.0), std::invalid_argument);
+    }
+
+    SECTION("Empty selections change nothing")
+    {
+        store.set_local_frame(LocalFrame(47.0, -122.0));
+        store.update_enu();
+        const std::vector<size_t> none;
+        translate_metres(store, none, 10.0, 10.0);
+        rotate_about(store, none, 47.0, -122.0, 90.0);
+        scale_about(store, none, 47.0, -122.0, 2.0);
+        REQUIRE(store.enu_current());
+        REQUIRE(store.latitudes()[0] == assets[0].latitude);
+        REQUIRE(store.headings()[0] == assets[0].heading);
+    }
+
+    SECTION("Rotate about a point fixes up headings")
+    {
+        std::vector<size_t> all(assets.size());
+        for (size_t i = 0; i < all.size(); ++i)
+            all[i] = i;
+
+        const double originLat = 47.04, originLon = -121.95;
+        rotate_about(store, all, originLat, originLon, 90.0);
+        for (size_t i = 0; i < assets.size(); ++i)
+        {
+            const double before = great_circle_distance(originLat, originLon, assets[i].latitude, assets[i].longitude);
+            const double after = great_circle_distance(originLat, originLon, store.latitudes()[i], store.longitudes()[i]);
+            REQUIRE(after == Approx(before).margin(1.0).epsilon(0.005));
+            REQUIRE(store.headings()[i] == Approx(std::fmod(assets[i].heading + 90.0, 360.0)));
+        }
+
+        // North of the origin turns to east of it
+        const size_t north = 8 * 11 + 5;
+        REQUIRE(store.latitudes()[north] == Approx(originLat).margin(1e-9));
+        REQUIRE(store.longitudes()[north] > originLon);
+
+        rotate_about(store, all, originLat, originLon, -90.0);
+        for (size_t i = 0; i < assets.size(); ++i)
+        {
+            REQUIRE(store.latitudes()[i] == Approx(assets[i].latitude).margin(1e-9));
+            REQUIRE(store.longitudes()[i] == Approx(assets[i].longitude).margin(1e-9));
+            REQUIRE(store.headings()[i] == Approx(assets[i].heading).margin(1e-9));
+        }
+    }
+
+    SECTION("Scale and rebase")
+    {
+        const auto even = select_layer(store, "even");
+        scale_about(store, even, 47.0, -122.0, 2.0);
+        for (const size_t i : even)
+        {
+            REQUIRE(store.latitudes()[i] - 47.0 == Approx(2.0 * (assets[i].latitude - 47.0)));
+            REQUIRE(store.headings()[i] == assets[i].heading);
+        }
+
+        AssetStore rebased(assets);
+        rebase_datum(rebased, 47.0, -122.0, -33.9, 151.2);
+        for (size_t i = 0; i < assets.size(); ++i)
+        {
+            const double before = great_circle_distance(47.0, -122.0, assets[i].latitude, assets[i].longitude);
+            const double after = great_circle_distance(-33.9, 151.2, rebased.latitudes()[i], rebased.longitudes()[i]);
+            REQUIRE(after == Approx(before).margin(1.0).epsilon(0.005));
+        }
+    }
+}
+
+TEST_CASE("Local ENU cache", "[assets][store][enu]")
+{
+    using namespace EdxTests::AssetStoreTests;
+
+    auto assets = CreateGridAssets(9, 11);
+    AssetStore store(assets);
+    REQUIRE(store.east().empty());
+
+    AirportInfo airport;
+    airport.datumLat = 47.04;
+    airport.datumLon = -121.95;
+    const LocalFrame frame(airport);
+    store.set_local_frame(frame);
+    REQUIRE_FALSE(store.enu_current());
+    REQUIRE_THROWS_AS(store.east(), std::logic_error);
+    store.update_enu();
+    REQUIRE(store.enu_current());
+
+    auto require_matches_frame = [&](const LocalFrame& expected)
+    {
+        store.update_enu();
+        REQUIRE(store.east().size() == store.size());
+        for (size_t i = 0; i < store.size(); ++i)
+        {
+            double east, north, up;
+            expected.to_enu(store.latitudes()[i], store.longitudes()[i], store.altitudes()[i], east, north, up);
+            REQUIRE(store.east()[i] == Approx(east).margin(1e-6));
+            REQUIRE(store.north()[i] == Approx(north).margin(1e-6));
+            REQUIRE(store.up()[i] == Approx(up).margin(1e-6));
+        }
+    };
+
+    SECTION("Planar distances match great-circle distances")
+    {
+        require_matches_frame(frame);
+        for (size_t i = 0; i < assets.size(); i += 7)
+        {
+            const double planar = std::hypot(store.east()[i], store.north()[i]);
+            REQUIRE(planar == Approx(great_circle_distance(airport.datumLat, airport.datumLon, assets[i].latitude, assets[i].longitude)).margin(0.5).epsilon(0.001));
+        }
+
+        double lat, lon, alt;
+        frame.from_enu(store.east()[5], store.north()[5], store.up()[5], lat, lon, alt);
+        REQUIRE(lat == Approx(assets[5].latitude).margin(1e-9));
+        REQUIRE(lon == Approx(assets[5].longitude).margin(1e-9));
+    }
+
+    SECTION("Moves and new assets are picked up")
+    {
+        REQUIRE(store.east().size() == store.size());
+        const double eastBefore = store.east()[3];
+        const double northBefore = store.north()[4];
+
+        const std::vector<size_t> moved = {3, 40};
+        translate_metres(store, moved, 25.0, 0.0);
+        REQUIRE_THROWS_AS(store.north(), std::logic_error);
+        store.update_enu();
+        REQUIRE(store.east()[3] == Approx(eastBefore + 25.0).epsilon(0.001));
+        REQUIRE(store.north()[4] == northBefore);
+
+        store.latitudes()[4] += 0.001;
+        store.invalidate_enu(std::vector<size_t>{4});
+        store.push_back(assets[0]);
+        require_matches_frame(frame);
+
+        translate_positions(store, 0.01, 0.0);
+        require_matches_frame(frame);
+    }
+
+    SECTION("A new datum recomputes every row")
+    {
+        REQUIRE(store.east().size() == store.size());
+        const LocalFrame moved(47.0, -122.0, 10.0);
+        store.set_local_frame(moved);
+        require_matches_frame(moved);
+
+        store.clear_local_frame();
+        REQUIRE(store.north().empty());
+    }
+}
@@ -16,9 +16,12 @@
 #include <map>
 #include <numbers>
 #include <set>
+#include <sstream>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <edX/config/edXConfig.h>
+#include <edX/include/edXFileIO.h>
+#include <edX/include/edXLibraryCatalog.h>
 #include <edX/include/edXLibraryFile.h>
 
 /// -------------------------------------------------------
@@ -576,6 +579,438 @@ TEST_CASE("Library Object Management", "[library][objects]")
         REQUIRE(hasVehicle);
         REQUIRE(hasLightingType);
     }
+
+    SECTION("Indexed lookups stay consistent")
+    {
+        // Large enough that a quadratic add_object would be noticeable
+        LibraryFile library;
+        for (int i = 0; i < 20000; ++i)
+        {
+            LibraryObject obj;
+            obj.id = "obj_" + std::to_string(i);
+            obj.uniqueId = UniqueId::from_hex32(0x10000 + i);
+            library.add_object(std::move(obj));
+        }
+        REQUIRE(library.get_object_count() == 20000);
+
+        LibraryObject duplicateUniqueId;
+        duplicateUniqueId.id = "fresh";
+        duplicateUniqueId.uniqueId = UniqueId::from_hex32(0x10005);
+        library.add_object(duplicateUniqueId);
+        REQUIRE(library.get_object_count() == 20000);
+
+        // Empty unique ids never collide
+        LibraryObject plain1, plain2;
+        plain1.id = "plain_1";
+        plain2.id = "plain_2";
+        library.add_object(plain1);
+        library.add_object(plain2);
+        REQUIRE(library.get_object_count() == 20002);
+
+        REQUIRE(library.find_object("obj_12345")->uniqueId == UniqueId::from_hex32(0x10000 + 12345));
+        REQUIRE(library.find_object_by_unique_id(UniqueId::from_hex32(0x10007))->id == "obj_7");
+
+        // Swap-and-pop moves the last object into the hole
+        REQUIRE(library.remove_object("obj_3"));
+        REQUIRE(library.objects[3].id == "plain_2");
+        REQUIRE(library.find_object("obj_3") == nullptr);
+        REQUIRE(library.find_object("plain_2") == &library.objects[3]);
+        REQUIRE(library.find_object_by_unique_id(UniqueId::from_hex32(0x10003)) == nullptr);
+
+        // Batch removal keeps the order of what is left
+        REQUIRE(library.remove_objects({"obj_0", "obj_2", "missing"}) == 2);
+        REQUIRE(library.objects[0].id == "obj_1");
+        REQUIRE(library.objects[1].id == "plain_2");
+        REQUIRE(library.objects[2].id == "obj_4");
+        REQUIRE(library.find_object("obj_4") == &library.objects[2]);
+
+        // In-place id edits need an explicit invalidation
+        library.objects[2].id = "renamed";
+        library.invalidate_object_indexes();
+        REQUIRE(library.find_object("renamed") == &library.objects[2]);
+        REQUIRE(library.find_object("obj_4") == nullptr);
+
+        // Copies rebuild their own indexes
+        const LibraryFile copy = library;
+        REQUIRE(copy.find_object("plain_1") == &copy.objects.back());
+    }
+
+    SECTION("Bulk ingestion reports duplicates")
+    {
+        LibraryFile library;
+        LibraryObject existing;
+        existing.id = "existing";
+        existing.uniqueId = UniqueId::from_hex32(0xfeed);
+        library.add_object(existing);
+
+        std::vector<LibraryObject> incoming(1000);
+        for (size_t i = 0; i < incoming.size(); ++i)
+        {
+            incoming[i].id = "bulk_" + std::to_string(i);
+            incoming[i].uniqueId = UniqueId::from_hex32(static_cast<uint32_t>(0x20000 + i));
+            incoming[i].properties = json{{"index", i}};
+        }
+        incoming[10].id = "existing";
+        incoming[20].id = "bulk_5";
+        incoming[30].uniqueId = UniqueId::from_hex32(0xfeed);
+        incoming[40].uniqueId = UniqueId();
+
+        const ObjectIngestReport report = library.add_objects(std::move(incoming));
+        REQUIRE(report.added == 997);
+        REQUIRE_FALSE(report.all_added());
+        REQUIRE(report.rejected.size() == 3);
+
+        REQUIRE(report.rejected[0].index == 10);
+        REQUIRE(report.rejected[0].id == "existing");
+        REQUIRE(report.rejected[0].reason == ObjectIngestReport::Reason::DuplicateId);
+        REQUIRE(report.rejected[1].index == 20);
+        REQUIRE(report.rejected[1].reason == ObjectIngestReport::Reason::DuplicateId);
+        REQUIRE(report.rejected[2].index == 30);
+        REQUIRE(report.rejected[2].uniqueId == UniqueId::from_hex32(0xfeed));
+        REQUIRE(report.rejected[2].reason == ObjectIngestReport::Reason::DuplicateUniqueId);
+
+        REQUIRE(library.get_object_count() == 998);
+        REQUIRE(library.objects[1].id == "bulk_0");
+        REQUIRE(library.find_object("bulk_40") != nullptr);
+        REQUIRE(library.find_object("bulk_999")->properties["index"] == 999);
+        REQUIRE(library.find_object_by_unique_id(UniqueId::from_hex32(0x20000 + 500))->id == "bulk_500");
+
+        REQUIRE(library.add_objects({}).all_added());
+    }
+}
+
+TEST_CASE("Library object facets", "[library][objects][facets]")
+{
+    LibraryFile library;
+    const auto make = [](std::string id, std::string category, std::string assetType, std::vector<std::string> tags)
+    {
+        LibraryObject obj;
+        obj.id = std::move(id);
+        obj.category = std::move(category);
+        obj.assetType = std::move(assetType);
+        obj.tags = std::move(tags);
+        return obj;
+    };
+
+    library.add_objects({
+        make("t1", "buildings", "building", {"modern", "glass"}),
+        make("t2", "buildings", "building", {"modern"}),
+        make("h1", "buildings", "hangar", {"metal", "modern", "modern"}),
+        make("v1", "ground_support", "vehicle", {"metal"}),
+        make("l1", "lighting", "light", {}),
+        make("x1", "", "", {"glass"})});
+
+    SECTION("Facet values and counts")
+    {
+        REQUIRE(library.get_categories() == std::vector<std::string>{"buildings", "ground_support", "lighting"});
+        REQUIRE(library.get_asset_types() == std::vector<std::string>{"building", "hangar", "light", "vehicle"});
+
+        const auto tags = library.facet_counts(ObjectFacet::Tag);
+        REQUIRE(tags == std::vector<std::pair<std::string, size_t>>{{"glass", 2}, {"metal", 2}, {"modern", 3}});
+
+        const auto positions = library.objects_with(ObjectFacet::AssetType, "building");
+        REQUIRE(std::vector<size_t>(positions.begin(), positions.end()) == std::vector<size_t>{0, 1});
+        REQUIRE(library.objects_with(ObjectFacet::Category, "missing").empty());
+    }
+
+    SECTION("Queries intersect facets")
+    {
+        REQUIRE(library.query_objects({.category = "buildings", .tags = {"modern"}}) == std::vector<size_t>{0, 1, 2});
+        REQUIRE(library.query_objects({.tags = {"modern", "metal"}}) == std::vector<size_t>{2});
+        REQUIRE(library.query_objects({.category = "buildings", .assetType = "vehicle"}).empty());
+        REQUIRE(library.query_objects({.tags = {"unknown"}}).empty());
+        REQUIRE(library.query_objects({}).size() == library.objects.size());
+
+        const auto counts = library.facet_counts(ObjectFacet::AssetType, {.tags = {"modern"}});
+        REQUIRE(counts == std::vector<std::pair<std::string, size_t>>{{"building", 2}, {"hangar", 1}});
+    }
+
+    SECTION("Indexes follow changes")
+    {
+        library.add_object(make("v2", "ground_support", "vehicle", {"metal"}));
+        REQUIRE(library.query_objects({.assetType = "vehicle"}) == std::vector<size_t>{3, 6});
+
+        REQUIRE(library.remove_object("t1"));
+        REQUIRE(library.query_objects({.assetType = "building"}).size() == 1);
+        REQUIRE(library.objects[library.query_objects({.assetType = "vehicle"}).front()].id == "v2");
+
+        library.objects.push_back(make("l2", "lighting", "light", {}));
+        REQUIRE(library.facet_counts(ObjectFacet::Category).back() == std::pair<std::string, size_t>{"lighting", 2});
+
+        library.objects[1].category = "retired";
+        library.invalidate_object_indexes();
+        REQUIRE(library.query_objects({.category = "retired"}) == std::vector<size_t>{1});
+
+        library.remove_objects({"h1", "v1"});
+        REQUIRE(library.facet_counts(ObjectFacet::Tag, {.category = "ground_support"}) == std::vector<std::pair<std::string, size_t>>{{"metal", 1}});
+    }
+
+    SECTION("Single removals update the index in place")
+    {
+        // A copy starts with no index, so it rebuilds from scratch
+        const auto matches_rebuild = [](const LibraryFile& edited)
+        {
+            const LibraryFile rebuilt = edited;
+            for (const ObjectFacet facet : {ObjectFacet::Category, ObjectFacet::AssetType, ObjectFacet::Tag})
+            {
+                if (edited.facet_counts(facet) != rebuilt.facet_counts(facet))
+                    return false;
+
+                for (const auto& [value, count] : rebuilt.facet_counts(facet))
+                {
+                    const auto a = edited.objects_with(facet, value);
+                    const auto b = rebuilt.objects_with(facet, value);
+                    if (!std::ranges::equal(a, b))
+                        return false;
+                }
+            }
+
+            return true;
+        };
+
+        REQUIRE(library.get_categories().size() == 3);
+        for (const char* id : {"v1", "x1", "t1", "l1", "h1"})
+        {
+            REQUIRE(library.remove_object(id));
+            REQUIRE(matches_rebuild(library));
+        }
+
+        REQUIRE(library.get_categories() == std::vector<std::string>{"buildings"});
+        REQUIRE(library.facet_counts(ObjectFacet::Tag) == std::vector<std::pair<std::string, size_t>>{{"modern", 1}});
+    }
+}
+
+TEST_CASE("Library object search", "[library][objects][search]")
+{
+    auto testDir = std::filesystem::current_path() / "test_output";
+    std::filesystem::create_directories(testDir);
+
+    LibraryFile library;
+    const auto make = [](std::string id, std::string name, std::string description, std::vector<std::string> tags)
+    {
+        LibraryObject obj;
+        obj.id = std::move(id);
+        obj.name = std::move(name);
+        obj.description = std::move(description);
+        obj.tags = std::move(tags);
+        return obj;
+    };
+
+    library.add_objects({
+        make("t1", "Terminal Building", "Modern glass terminal", {"terminal"}),
+        make("h1", "Hangar Large", "Maintenance hangar next to the terminal", {"metal"}),
+        make("g1", "Glass Jetway", "Passenger bridge", {"jetway", "glass"}),
+        make("t2", "Terminal", "Small regional terminal", {}),
+        make("b1", "Baggage Cart", "", {"ground-equipment"})});
+
+    const auto ids = [&library](const std::vector<SearchHit>& hits)
+    {
+        std::vector<std::string> result;
+        for (const auto& hit : hits)
+            result.push_back(library.objects[hit.position].id);
+        return result;
+    };
+
+    SECTION("Ranks name matches above tags and descriptions")
+    {
+        REQUIRE(ids(library.search_objects("terminal")) == std::vector<std::string>{"t2", "t1", "h1"});
+        REQUIRE(ids(library.search_objects("GLASS")) == std::vector<std::string>{"g1", "t1"});
+        REQUIRE(ids(library.search_objects("term build")) == std::vector<std::string>{"t1"});
+        REQUIRE(ids(library.search_objects("equip")) == std::vector<std::string>{"b1"});
+        REQUIRE(ids(library.search_objects("ga")) == std::vector<std::string>{"h1", "b1"});
+        REQUIRE(library.search_objects("terminal", 1).size() == 1);
+        REQUIRE(library.search_objects("runway").empty());
+        REQUIRE(library.search_objects("  ").empty());
+    }
+
+    SECTION("Follows adds and removals")
+    {
+        library.add_object(make("t3", "Cargo Terminal", "", {}));
+        REQUIRE(ids(library.search_objects("cargo")) == std::vector<std::string>{"t3"});
+
+        REQUIRE(library.remove_object("t1"));
+        REQUIRE(library.remove_object("g1"));
+        REQUIRE(ids(library.search_objects("terminal")) == std::vector<std::string>{"t2", "t3", "h1"});
+        REQUIRE(library.search_objects("jetway").empty());
+
+        library.objects[0].name = "Renamed Stand";
+        library.invalidate_object_indexes();
+        REQUIRE(library.objects[library.search_objects("stand").front().position].id == library.objects[0].id);
+    }
+
+    SECTION("Persists next to the library file")
+    {
+        auto libraryPath = testDir / "search_library.edxlib";
+        SaveOptions options;
+        options.searchIndex = true;
+        REQUIRE(library.save_to_file(libraryPath, options));
+        REQUIRE(std::filesystem::exists(LibraryFile::search_index_path(libraryPath)));
+
+        LibraryFile loaded;
+        REQUIRE(loaded.load_from_file(libraryPath));
+        REQUIRE(loaded.search_objects("terminal").size() == 3);
+
+        std::ostringstream stream;
+        StreamSink sink(stream);
+        library.write_search_index(sink);
+        const std::string bytes = stream.str();
+
+        LibraryFile other;
+        other.add_object(make("x", "Other", "", {}));
+        REQUIRE_FALSE(other.read_search_index(bytes));
+        REQUIRE_FALSE(loaded.read_search_index(std::string_view(bytes).substr(0, bytes.size() - 2)));
+        REQUIRE(loaded.read_search_index(bytes));
+    }
+
+    SECTION("Searches several libraries")
+    {
+        LibraryFile second;
+        second.add_object(make("s1", "Terminal", "", {}));
+        const LibraryFile* libraries[] = {&library, &second};
+
+        const auto hits = search_libraries(libraries, "terminal", 3);
+        REQUIRE(hits.size() == 3);
+        REQUIRE(hits[0].library == 0);
+        REQUIRE(library.objects[hits[0].position].id == "t2");
+        REQUIRE(hits[1].library == 1);
+        REQUIRE(hits[1].score == hits[0].score);
+    }
+}
+
+TEST_CASE("Library catalog", "[library][catalog]")
+{
+    auto testDir = std::filesystem::current_path() / "test_output" / "catalog";
+    std::filesystem::remove_all(testDir);
+    std::filesystem::create_directories(testDir / "nested");
+
+    const auto write_library = [&](const std::filesystem::path& path, const std::string& name, int objectCount)
+    {
+        LibraryFile library;
+        library.library.name = name;
+        library.library.version = "1.0.0";
+        for (int i = 0; i < objectCount; ++i)
+        {
+            LibraryObject obj;
+            obj.id = name + "_" + std::to_string(i);
+            obj.uniqueId = UniqueId::from_hex32(0x3000 + i);
+            obj.name = "Object " + std::to_string(i);
+            obj.category = i % 2 == 0 ? "buildings" : "vehicles";
+            obj.assetType = "model";
+            obj.tags = {"tag_" + std::to_string(i % 3)};
+            library.add_object(obj);
+        }
+        REQUIRE(library.save_to_file(path));
+    };
+
+    const auto alpha = testDir / "alpha.edxlib";
+    const auto beta = testDir / "nested" / "beta.edxlib";
+    const auto gamma = testDir / "gamma.edxlib";
+    write_library(alpha, "Alpha", 4);
+    write_library(beta, "Beta", 3);
+    write_library(gamma, "Gamma", 1);
+    std::ofstream(testDir / "notes.txt") << "not a library";
+
+    // Keep the libraries older than the catalog and apart from each other,
+    // whatever the file system's timestamp resolution
+    const auto written = std::filesystem::last_write_time(gamma);
+    std::filesystem::last_write_time(alpha, written - std::chrono::hours(3));
+    std::filesystem::last_write_time(beta, written - std::chrono::hours(2));
+    std::filesystem::last_write_time(gamma, written - std::chrono::hours(1));
+
+    const auto catalogPath = testDir / "libraries.catalog";
+    {
+        LibraryCatalog catalog;
+        REQUIRE_FALSE(catalog.load(catalogPath));
+
+        const auto result = catalog.refresh(testDir);
+        REQUIRE(result.parsed == 3);
+        REQUIRE(result.failed.empty());
+        REQUIRE(catalog.dirty());
+        REQUIRE(catalog.save(catalogPath));
+        REQUIRE_FALSE(catalog.dirty());
+
+        const CatalogEntry* entry = catalog.find(alpha);
+        REQUIRE(entry != nullptr);
+        REQUIRE(entry->library.name == "Alpha");
+        REQUIRE(entry->objects.size() == 4);
+        REQUIRE(entry->objects[1].uniqueId == UniqueId::from_hex32(0x3001));
+        REQUIRE(entry->categories == std::vector<std::pair<std::string, size_t>>{{"buildings", 2}, {"vehicles", 2}});
+        REQUIRE(entry->assetTypes == std::vector<std::pair<std::string, size_t>>{{"model", 4}});
+    }
+
+    SECTION("Unchanged libraries are served from the catalog")
+    {
+        LibraryCatalog catalog;
+        REQUIRE(catalog.load(catalogPath));
+        REQUIRE(catalog.entries().size() == 3);
+
+        const auto result = catalog.refresh(testDir);
+        REQUIRE(result.unchanged == 3);
+        REQUIRE(result.parsed == 0);
+        REQUIRE_FALSE(catalog.dirty());
+        REQUIRE(catalog.find(beta)->objects.back().tags == std::vector<std::string>{"tag_2"});
+    }
+
+    SECTION("Changes are revalidated incrementally")
+    {
+        // Same bytes, another time: hashed but not parsed
+        std::filesystem::last_write_time(alpha, std::filesystem::last_write_time(alpha) - std::chrono::hours(1));
+        write_library(beta, "Beta", 5);
+        std::filesystem::last_write_time(beta, written - std::chrono::minutes(30));
+        std::filesystem::remove(gamma);
+        std::ofstream(testDir / "broken.edxlib") << "{ not json";
+
+        LibraryCatalog catalog;
+        REQUIRE(catalog.load(catalogPath));
+        const auto result = catalog.refresh(testDir);
+        REQUIRE(result.unchanged == 0);
+        REQUIRE(result.touched == 1);
+        REQUIRE(result.parsed == 1);
+        REQUIRE(result.removed == 1);
+        REQUIRE(result.failed.size() == 1);
+        REQUIRE(catalog.dirty());
+
+        REQUIRE(catalog.entries().size() == 2);
+        REQUIRE(catalog.find(beta)->objects.size() == 5);
+        REQUIRE(catalog.find(gamma) == nullptr);
+
+        REQUIRE(catalog.save(catalogPath));
+        LibraryCatalog reloaded;
+        REQUIRE(reloaded.load(catalogPath));
+        REQUIRE(reloaded.refresh(testDir).unchanged == 2);
+    }
+
+    SECTION("Racy entries are hashed before they are trusted")
+    {
+        // Rewrite gamma with the same size and time, as if within the same
+        // timestamp tick as the catalog save
+        const auto modified = std::filesystem::last_write_time(gamma);
+        write_library(gamma, "Omega", 1);
+        std::filesystem::last_write_time(gamma, modified);
+        std::filesystem::last_write_time(catalogPath, modified);
+
+        LibraryCatalog catalog;
+        REQUIRE(catalog.load(catalogPath));
+        const auto result = catalog.refresh(testDir);
+        REQUIRE(result.unchanged == 2);
+        REQUIRE(result.parsed == 1);
+        REQUIRE(catalog.find(gamma)->library.name == "Omega");
+
+        // Saving settles the entry
+        REQUIRE(catalog.save(catalogPath));
+        LibraryCatalog reloaded;
+        REQUIRE(reloaded.load(catalogPath));
+        REQUIRE(reloaded.refresh(testDir).unchanged == 3);
+    }
+
+    SECTION("Corrupt catalogs are ignored")
+    {
+        std::ofstream(catalogPath, std::ios::binary | std::ios::trunc) << "garbage";
+        LibraryCatalog catalog;
+        REQUIRE_FALSE(catalog.load(catalogPath));
+        REQUIRE(catalog.entries().empty());
+        REQUIRE(catalog.refresh(testDir).parsed == 3);
+    }
 }
 
 TEST_CASE("Library Validation", "[library][validation]")
@@ -617,6 +1052,166 @@ TEST_CASE("Library Validation", "[library][validation]")
     }
 }
 
+TEST_CASE("Memory-mapped file input", "[library][file-io]")
+{
+    using namespace EdxTests::LibraryFileTests;
+
+    auto testDir = std::filesystem::current_path() / "test_output";
+    std::filesystem::create_directories(testDir);
+
+    SECTION("Mapped view matches file contents")
+    {
+        auto path = testDir / "mapped_contents.txt";
+        const std::string contents = "{\"Library\": {}}\n";
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << contents;
+        }
+
+        auto mapped = MappedFile::open(path);
+        REQUIRE(mapped != nullptr);
+        REQUIRE(mapped->size() == contents.size());
+        REQUIRE(mapped->view() == contents);
+    }
+
+    SECTION("Empty and missing files")
+    {
+        auto emptyPath = testDir / "mapped_empty.txt";
+        std::ofstream(emptyPath).close();
+
+        auto mapped = MappedFile::open(emptyPath);
+        REQUIRE(mapped->size() == 0);
+        REQUIRE(mapped->view().empty());
+
+        REQUIRE_THROWS_AS(MappedFile::open(testDir / "does_not_exist.edxlib"), std::runtime_error);
+
+        LibraryFile library;
+        REQUIRE_FALSE(library.load_from_file(emptyPath));
+    }
+
+    SECTION("Library loads from a mapped buffer")
+    {
+        LibraryFile original = CreateSampleLibrary();
+        auto path = testDir / "mapped_library.edxlib";
+        REQUIRE(original.save_to_file(path));
+
+        auto mapped = MappedFile::open(path);
+        LibraryFile fromBuffer;
+        fromBuffer.from_json_buffer(mapped->view());
+
+        LibraryFile fromFile;
+        REQUIRE(fromFile.load_from_file(path));
+
+        json bufferJson, fileJson;
+        fromBuffer.to_json(bufferJson);
+        fromFile.to_json(fileJson);
+        REQUIRE(bufferJson == fileJson);
+        REQUIRE(fromBuffer.objects.size() == original.objects.size());
+    }
+}
+
+TEST_CASE("Atomic file writes", "[library][file-io]")
+{
+    using namespace EdxTests::LibraryFileTests;
+
+    auto testDir = std::filesystem::current_path() / "test_output" / "atomic";
+    std::filesystem::remove_all(testDir);
+    std::filesystem::create_directories(testDir);
+
+    auto read_file = [](const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+
+    auto target = testDir / "atomic_target.txt";
+
+    SECTION("Commit replaces the target and leaves no temporary files")
+    {
+        std::ofstream(target) << "old contents";
+
+        for (auto durability : {Durability::None, Durability::Data, Durability::Full})
+        {
+            AtomicFileWriter writer(target, durability, 4);
+            writer.write("new ", 4);
+            writer.write("contents that exceed the buffer", 31);
+            writer.commit();
+
+            REQUIRE(read_file(target) == "new contents that exceed the buffer");
+        }
+
+        REQUIRE(std::distance(std::filesystem::directory_iterator(testDir), std::filesystem::directory_iterator()) == 1);
+    }
+
+    SECTION("Abandoned writer keeps the original file")
+    {
+        std::ofstream(target) << "old contents";
+
+        {
+            AtomicFileWriter writer(target);
+            writer.write("partial", 7);
+        }
+
+        REQUIRE(read_file(target) == "old contents");
+        REQUIRE(std::distance(std::filesystem::directory_iterator(testDir), std::filesystem::directory_iterator()) == 1);
+    }
+
+    SECTION("Library save goes through the atomic writer")
+    {
+        LibraryFile library = CreateSampleLibrary();
+        auto libraryPath = testDir / "atomic_library.edxlib";
+
+        SaveOptions options;
+        options.durability = Durability::Full;
+        REQUIRE(library.save_to_file(libraryPath, options));
+        REQUIRE(library.save_to_file(libraryPath, options));
+
+        LibraryFile loaded;
+        REQUIRE(loaded.load_from_file(libraryPath));
+        REQUIRE(loaded.objects.size() == library.objects.size());
+
+        REQUIRE_FALSE(library.save_to_file(testDir / "missing_dir" / "library.edxlib"));
+    }
+
+    SECTION("Direct serialization matches the json tree")
+    {
+        LibraryFile library = CreateSampleLibrary();
+
+        json reference;
+        library.to_json(reference);
+
+        std::ostringstream stream;
+        StreamSink sink(stream);
+        library.write_json(sink);
+        REQUIRE(stream.str() == reference.dump(4));
+    }
+
+    SECTION("Compressed library round trip")
+    {
+        LibraryFile library = CreateSampleLibrary();
+        auto libraryPath = testDir / "compressed_library.edxlib";
+
+        SaveOptions options;
+        options.compression = Compression::Zstd;
+        if (!is_compression_available())
+        {
+            REQUIRE_FALSE(library.save_to_file(libraryPath, options));
+            return;
+        }
+
+        REQUIRE(library.save_to_file(libraryPath, options));
+
+        LibraryFile loaded;
+        REQUIRE(loaded.load_from_file(libraryPath));
+        REQUIRE(loaded.objects.size() == library.objects.size());
+        REQUIRE(loaded.objects[0].uniqueId == library.objects[0].uniqueId);
+
+        auto header = LibraryFileHeader::probe(libraryPath);
+        REQUIRE(header.has_value());
+        REQUIRE(header->library.name == library.library.name);
+    }
+}
+
 TEST_CASE("Random Hex Value Generation", "[library][utility]")
 {
     using namespace EdxTests::LibraryFileTests;
@@ -942,3 +1537,81 @@ TEST_CASE("Generate demonstration files for manual inspection", "[file-generatio
         INFO("  JSON file: " << minimalJsonPath.string());
     }
 }
+
+TEST_CASE("Compact unique IDs", "[library][uniqueid]")
+{
+    SECTION("Hex ids are packed and print unchanged")
+    {
+        for (const char* text : {"0", "00a1b2c3", "ffffffff", "0123456789abcde"})
+        {
+            const UniqueId id = text;
+            REQUIRE(id.is_hex());
+            REQUIRE(id.str() == text);
+        }
+
+        REQUIRE(UniqueId("00a1b2c3") != UniqueId("a1b2c3"));
+        REQUIRE(UniqueId::from_hex32(0xa1b2c3) == "00a1b2c3");
+        REQUIRE(UniqueId::generate().str().length() == 8);
+        REQUIRE(UniqueId().empty());
+        REQUIRE(UniqueId("").empty());
+    }
+
+    SECTION("Other text is kept by the ids that use it")
+    {
+        for (const char* text : {"A1B2C3D4", "uid_7", "0123456789abcdef0", "caf\xC3\xA9"})
+        {
+            const UniqueId id = text;
+            REQUIRE_FALSE(id.is_hex());
+            REQUIRE(id.str() == text);
+            REQUIRE(id == UniqueId(std::string(text)));
+        }
+
+        REQUIRE(UniqueId("ABCDEF") != UniqueId("abcdef"));
+        REQUIRE(std::hash<UniqueId>{}(UniqueId("uid_7")) == std::hash<UniqueId>{}(UniqueId("uid_7")));
+
+        // Copies share the text and outlive the original
+        UniqueId copy;
+        {
+            const UniqueId original = "6F9619FF-8B86-D011-B42D-00C04FC964FF";
+            copy = original;
+            UniqueId moved = original;
+            UniqueId target = std::move(moved);
+            REQUIRE(moved.empty());
+            REQUIRE(target == original);
+        }
+        REQUIRE(copy.str() == "6F9619FF-8B86-D011-B42D-00C04FC964FF");
+        copy = copy;
+        REQUIRE(copy == "6F9619FF-8B86-D011-B42D-00C04FC964FF");
+
+        // Comparing with text never creates an id
+        REQUIRE(copy != "6f9619ff-8b86-d011-b42d-00c04fc964ff");
+        REQUIRE(copy != std::string("never-seen-before"));
+        REQUIRE(UniqueId("00a1b2c3") == std::string_view("00a1b2c3"));
+        REQUIRE(UniqueId("00a1b2c3") != "a1b2c3");
+        REQUIRE(UniqueId() == "");
+        REQUIRE(UniqueId("uid_7") != "");
+    }
+
+    SECTION("Duplicate unique ids are reported")
+    {
+        LibraryFile library;
+        library.library.name = "Unique Id Library";
+        library.library.version = "1.0.0";
+        for (int i = 0; i < 3; ++i)
+        {
+            LibraryObject obj;
+            obj.id = "object_" + std::to_string(i);
+            obj.uniqueId = i == 2 ? "0000abcd" : UniqueId::from_hex32(0xabcd + i).str();
+            obj.assetType = "building";
+            obj.name = "Object";
+            library.objects.push_back(obj);
+        }
+
+        const auto errors = library.get_validation_errors();
+        REQUIRE(std::ranges::count(errors, std::string("Duplicate object unique ID: 0000abcd")) == 1);
+
+        json j;
+        library.to_json(j);
+        REQUIRE(j["Objects"][2]["unique-id"] == "0000abcd");
+    }
+}
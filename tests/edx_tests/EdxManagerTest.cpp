@@ -290,6 +290,88 @@ TEST_CASE("Manager Validation Functions", "[manager][validation]")
     }
 }
 
+TEST_CASE("Manager File Header Probe", "[manager][probe]")
+{
+    using namespace EdxTests::ManagerTests;
+
+    auto testDir = std::filesystem::current_path() / "test_output";
+    std::filesystem::create_directories(testDir);
+
+    EdxManager manager;
+
+    SECTION("Project header without a full load")
+    {
+        auto project = manager.create_project("Probe Project", "Test Author", "KPRB");
+        project->airport.name = "Probe Airport";
+        project->airport.datumLat = 40.0;
+        project->airport.datumLon = -75.0;
+        for (int i = 0; i < 100; ++i)
+        {
+            SceneAsset asset;
+            asset.id = "asset_" + std::to_string(i);
+            asset.uniqueId = generate_unique_id();
+            asset.otherProperties["note"] = "braces { and ] inside \"strings\"";
+            project->assets.push_back(asset);
+        }
+
+        auto jsonPath = testDir / "probe_project.edX";
+        auto binaryPath = testDir / "probe_project.edxb";
+        REQUIRE(manager.save_project(*project, jsonPath.string()));
+        REQUIRE(manager.save_binary_project(*project, binaryPath.string()));
+
+        REQUIRE(manager.is_valid_project_file(jsonPath.string()));
+        REQUIRE(manager.is_valid_project_file(binaryPath.string()));
+
+        auto header = manager.read_project_header(jsonPath.string());
+        REQUIRE(header.has_value());
+        REQUIRE(header->project.name == "Probe Project");
+        REQUIRE(header->project.author == "Test Author");
+        REQUIRE(header->airport.icao == "KPRB");
+        REQUIRE(header->airport.name == "Probe Airport");
+        REQUIRE_FALSE(header->binary);
+
+        auto binaryHeader = manager.read_project_header(binaryPath.string());
+        REQUIRE(binaryHeader.has_value());
+        REQUIRE(binaryHeader->project.name == "Probe Project");
+        REQUIRE(binaryHeader->binary);
+    }
+
+    SECTION("Library header without a full load")
+    {
+        auto library = manager.create_library("Probe Library", "Test Author", "2.1.0");
+        library->library.description = "Library used by the probe test";
+        auto libraryPath = testDir / "probe_library.edxlib";
+        REQUIRE(manager.save_library(*library, libraryPath.string()));
+
+        REQUIRE(manager.is_valid_library_file(libraryPath.string()));
+
+        auto header = manager.read_library_header(libraryPath.string());
+        REQUIRE(header.has_value());
+        REQUIRE(header->library.name == "Probe Library");
+        REQUIRE(header->library.version == "2.1.0");
+    }
+
+    SECTION("Reject files that are not edX documents")
+    {
+        auto write_file = [&](const std::string& name, const std::string& contents)
+        {
+            auto path = testDir / name;
+            std::ofstream file(path);
+            file << contents;
+            return path.string();
+        };
+
+        REQUIRE_FALSE(manager.is_valid_project_file(write_file("probe_text.edX", "not json")));
+        REQUIRE_FALSE(manager.is_valid_project_file(write_file("probe_array.edX", "[1, 2, 3]")));
+        REQUIRE_FALSE(manager.is_valid_project_file(write_file("probe_no_project.edX", "{\"Assets\": []}")));
+        REQUIRE_FALSE(manager.is_valid_project_file(write_file("probe_bad_assets.edX", "{\"Assets\": 5, \"Project\": {}}")));
+        REQUIRE_FALSE(manager.is_valid_project_file(write_file("probe_truncated.edX", "{\"Assets\": [{\"id\": \"a\"")));
+        REQUIRE_FALSE(manager.is_valid_project_file((testDir / "probe_missing.edX").string()));
+        REQUIRE_FALSE(manager.is_valid_library_file(write_file("probe_library_text.edxlib", "{\"Library\": 42}")));
+        REQUIRE(manager.is_valid_project_file(write_file("probe_minimal.edX", "\xEF\xBB\xBF { \"Project\" : {\"name\": \"Min\"} }")));
+    }
+}
+
 TEST_CASE("Manager Error Handling", "[manager][error-handling]")
 {
     using namespace EdxTests::ManagerTests;
@@ -11,13 +11,17 @@
 * -------------------------------------------------------
 */
 #include <chrono>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <set>
+#include <sstream>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <edX/config/edXConfig.h>
 #include <edX/include/edXManager.h>
 #include <edX/include/edXProjectFile.h>
+#include <edX/include/edXSpatialIndex.h>
 
 /// -------------------------------------------------------
 
@@ -652,3 +656,792 @@ TEST_CASE("Generate complete demonstration project for inspection", "[project][d
         INFO("  File size: " << std::filesystem::file_size(mainProjectPath) / 1024.0 << " KB");
     }
 }
+
+TEST_CASE("Streaming project load", "[project][streaming]")
+{
+    using namespace EdxTests::ProjectFileComprehensiveTests;
+
+    auto testDir = std::filesystem::current_path() / "test_output";
+    std::filesystem::create_directories(testDir);
+
+    SECTION("Streaming load matches DOM load")
+    {
+        EdxProject project = CreateRealisticAirportProject();
+        project.settings["renderDistance"] = 50000;
+        project.layers[0].assetIds = {"terminal_1", "terminal_2"};
+        project.layers[0].layerProperties["color"] = "#ff0000";
+
+        auto projectPath = testDir / "streaming_load_project.edx";
+        REQUIRE(project.save_to_file(projectPath));
+
+        // Reference result through the DOM path
+        std::ifstream file(projectPath);
+        json fileJson;
+        file >> fileJson;
+        file.close();
+
+        EdxProject domProject;
+        domProject.from_json(fileJson);
+
+        EdxProject streamedProject;
+        REQUIRE(streamedProject.load_from_file(projectPath));
+
+        json domJson, streamedJson;
+        domProject.to_json(domJson);
+        streamedProject.to_json(streamedJson);
+        REQUIRE(streamedJson == domJson);
+        REQUIRE(streamedProject.layers[0].assetIds.size() == 2);
+        REQUIRE(streamedProject.settings["renderDistance"] == 50000);
+    }
+
+    SECTION("Unknown keys are skipped and numeric types are converted")
+    {
+        std::istringstream input(R"({
+            "Unknown": {"nested": [1, 2, {"deep": true}]},
+            "Assets": [
+                {"id": "a", "latitude": 10, "heading": true, "extra": [1, {"x": 2}], "other-properties": {"k": [1, 2]}},
+                {"id": "b", "longitude": -1.5e1}
+            ],
+            "Layers": [{"layer-id": "l", "z-order": 3.7, "asset-ids": ["a", "b"]}]
+        })");
+
+        EdxProject project;
+        project.from_json_stream(input);
+
+        REQUIRE(project.assets.size() == 2);
+        REQUIRE(project.assets[0].latitude == Approx(10.0));
+        REQUIRE(project.assets[0].heading == Approx(1.0));
+        REQUIRE(project.assets[0].otherProperties["k"].size() == 2);
+        REQUIRE(project.assets[1].longitude == Approx(-15.0));
+        REQUIRE(project.layers[0].zOrder == 3);
+        REQUIRE(project.layers[0].assetIds == std::vector<std::string>{"a", "b"});
+    }
+
+    SECTION("Type mismatches and syntax errors fail without touching the project")
+    {
+        EdxProject project = CreateRealisticAirportProject();
+        const auto assetCount = project.assets.size();
+
+        std::istringstream wrongType(R"({"Assets": [{"id": 42}]})");
+        REQUIRE_THROWS(project.from_json_stream(wrongType));
+
+        std::istringstream truncated(R"({"Assets": [{"id": "a"}, {"id": )");
+        REQUIRE_THROWS_AS(project.from_json_stream(truncated), json::parse_error);
+        REQUIRE(project.assets.size() == assetCount);
+    }
+}
+
+TEST_CASE("Direct project serialization", "[project][serialization]")
+{
+    using namespace EdxTests::ProjectFileComprehensiveTests;
+
+    EdxProject project = CreateRealisticAirportProject();
+    project.settings["renderDistance"] = 50000;
+    project.settings["units"] = "metric";
+    project.layers[0].assetIds = {"terminal_1", "terminal_2"};
+    project.layers[0].layerProperties["color"] = "#ff0000";
+    project.assets[0].associatedLibrary = "Caf\xC3\xA9 \"quoted\" \\ path\ttab";
+    project.assets[0].latitude = 0.1;
+    project.assets[1].altitude = -1.0e-7;
+
+    json reference;
+    project.to_json(reference);
+
+    SECTION("Pretty output matches dump(4)")
+    {
+        std::ostringstream stream;
+        project.write_json(stream);
+        REQUIRE(stream.str() == reference.dump(4));
+    }
+
+    SECTION("Compact output matches dump()")
+    {
+        SaveOptions options;
+        options.prettyPrint = false;
+
+        std::ostringstream stream;
+        project.write_json(stream, options);
+        REQUIRE(stream.str() == reference.dump());
+    }
+
+    SECTION("Empty project")
+    {
+        EdxProject empty;
+        json emptyJson;
+        empty.to_json(emptyJson);
+
+        std::ostringstream stream;
+        empty.write_json(stream);
+        REQUIRE(stream.str() == emptyJson.dump(4));
+    }
+}
+
+TEST_CASE("Binary project format", "[project][binary]")
+{
+    using namespace EdxTests::ProjectFileComprehensiveTests;
+
+    auto testDir = std::filesystem::current_path() / "test_output";
+    std::filesystem::create_directories(testDir);
+
+    EdxProject project = CreateRealisticAirportProject();
+    project.settings["renderDistance"] = 50000;
+    project.layers[0].assetIds = {"terminal_1", "terminal_2"};
+    project.assets[0].locked = true;
+    project.assets[1].hidden = true;
+    project.assets[1].selected = true;
+    project.assets[2].groupId = "group_a";
+    project.assets[3].latitude = 0.1 + 0.2;
+
+    json reference;
+    project.to_json(reference);
+
+    SECTION("Round-trips losslessly with JSON")
+    {
+        auto binaryPath = testDir / "binary_round_trip.edxb";
+        REQUIRE(project.save_to_binary_file(binaryPath));
+
+        EdxProject loaded;
+        REQUIRE(loaded.load_from_binary_file(binaryPath));
+
+        json loadedJson;
+        loaded.to_json(loadedJson);
+        REQUIRE(loadedJson.dump(4) == reference.dump(4));
+        REQUIRE(loaded.assets[3].latitude == project.assets[3].latitude);
+
+        auto jsonPath = testDir / "binary_round_trip.edx";
+        REQUIRE(project.save_to_file(jsonPath));
+        REQUIRE(std::filesystem::file_size(binaryPath) < std::filesystem::file_size(jsonPath));
+    }
+
+    SECTION("Manager entry points")
+    {
+        EdxManager manager;
+        auto binaryPath = testDir / "binary_manager.edxb";
+        REQUIRE(manager.save_binary_project(project, binaryPath.string()));
+
+        auto loaded = manager.load_binary_project(binaryPath.string());
+        REQUIRE(loaded != nullptr);
+        REQUIRE(loaded->assets.size() == project.assets.size());
+        REQUIRE(loaded->libraries.size() == project.libraries.size());
+
+        // The generic loader accepts every file the manager reports as valid
+        REQUIRE(manager.is_valid_project_file(binaryPath.string()));
+        auto generic = manager.load_project(binaryPath.string());
+        REQUIRE(generic != nullptr);
+        REQUIRE(generic->assets.size() == project.assets.size());
+    }
+
+    SECTION("Rejects non-binary and truncated data")
+    {
+        std::ostringstream stream;
+        StreamSink sink(stream);
+        project.write_binary(sink);
+        const std::string bytes = stream.str();
+        REQUIRE(EdxProject::is_binary_data(bytes));
+
+        EdxProject target;
+        REQUIRE_THROWS(target.from_binary_buffer("{\"Project\": {}}"));
+        REQUIRE_THROWS(target.from_binary_buffer(std::string_view(bytes).substr(0, bytes.size() / 2)));
+        REQUIRE(target.assets.empty());
+
+        // Only version 1 exists
+        for (const char version : {'\0', '\2'})
+        {
+            std::string versioned = bytes;
+            versioned[4] = version;
+            REQUIRE_THROWS(target.from_binary_buffer(versioned));
+        }
+
+        // An asset count the chunk cannot hold is rejected before anything is allocated
+        const auto append_pod = [](std::string& out, const auto value) { out.append(reinterpret_cast<const char*>(&value), sizeof(value)); };
+        std::string inflated = bytes.substr(0, 8);
+        inflated += "META";
+        append_pod(inflated, uint64_t{1});
+        inflated += '\xA0'; // empty CBOR map
+        inflated += "ASET";
+        append_pod(inflated, uint64_t{sizeof(uint64_t) + 1000});
+        append_pod(inflated, uint64_t{1000});
+        inflated.append(1000, '\0');
+
+        std::string error;
+        try
+        {
+            target.from_binary_buffer(inflated);
+        }
+        catch (const std::exception& e)
+        {
+            error = e.what();
+        }
+        REQUIRE(error.find("asset count exceeds chunk size") != std::string::npos);
+    }
+
+    SECTION("Bad metadata leaves the target unchanged")
+    {
+        std::ostringstream stream;
+        StreamSink sink(stream);
+        project.write_binary(sink);
+        const std::string bytes = stream.str();
+
+        // Replace the leading META chunk with one whose Layers fail to decode
+        // after Project, Airport and Libraries have been read
+        json metadata = reference;
+        metadata.erase("Assets");
+        metadata["Project"]["name"] = "Replaced";
+        metadata["Layers"] = json::array({42});
+        const std::vector<uint8_t> cbor = json::to_cbor(metadata);
+
+        uint64_t metadataSize = 0;
+        REQUIRE(bytes.compare(8, 4, "META") == 0);
+        std::memcpy(&metadataSize, bytes.data() + 12, sizeof(metadataSize));
+
+        const uint64_t patchedSize = cbor.size();
+        std::string patched = bytes.substr(0, 12);
+        patched.append(reinterpret_cast<const char*>(&patchedSize), sizeof(patchedSize));
+        patched.append(cbor.begin(), cbor.end());
+        patched += bytes.substr(20 + metadataSize);
+
+        EdxProject target;
+        target.from_binary_buffer(bytes);
+        REQUIRE_THROWS(target.from_binary_buffer(patched));
+
+        json unchanged;
+        target.to_json(unchanged);
+        REQUIRE(unchanged == reference);
+    }
+}
+
+TEST_CASE("Lazy project loading", "[project][lazy]")
+{
+    using namespace EdxTests::ProjectFileComprehensiveTests;
+
+    auto testDir = std::filesystem::current_path() / "test_output";
+    std::filesystem::create_directories(testDir);
+
+    EdxProject project = CreateRealisticAirportProject();
+    project.settings["renderDistance"] = 50000;
+    project.layers[0].assetIds = {"terminal_1", "terminal_2"};
+
+    auto projectPath = testDir / "lazy_project.edx";
+    REQUIRE(project.save_to_file(projectPath));
+
+    json reference;
+    project.to_json(reference);
+
+    SECTION("Metadata is available before sections load")
+    {
+        LazyEdxProject lazy;
+        REQUIRE(lazy.open(projectPath));
+
+        REQUIRE(lazy.project().name == project.project.name);
+        REQUIRE(lazy.airport().icao == project.airport.icao);
+        REQUIRE(lazy.libraries().size() == project.libraries.size());
+
+        REQUIRE_FALSE(lazy.assets_loaded());
+        REQUIRE_FALSE(lazy.layers_loaded());
+        REQUIRE_FALSE(lazy.settings_loaded());
+        REQUIRE(lazy.assets_span().has_value());
+        REQUIRE(lazy.assets_span()->length > 0);
+
+        REQUIRE(lazy.assets().size() == project.assets.size());
+        REQUIRE(lazy.assets_loaded());
+        REQUIRE_FALSE(lazy.layers_loaded());
+        REQUIRE(lazy.assets()[0].id == project.assets[0].id);
+
+        REQUIRE(lazy.settings()["renderDistance"] == 50000);
+        REQUIRE(lazy.layers()[0].assetIds.size() == 2);
+    }
+
+    SECTION("Taking the project matches a full load")
+    {
+        LazyEdxProject lazy;
+        REQUIRE(lazy.open(projectPath));
+        lazy.assets();
+
+        EdxProject taken = lazy.take_project();
+        json takenJson;
+        taken.to_json(takenJson);
+        REQUIRE(takenJson == reference);
+    }
+
+    SECTION("Manager entry point and binary projects")
+    {
+        EdxManager manager;
+        auto binaryPath = testDir / "lazy_project.edxb";
+        REQUIRE(project.save_to_binary_file(binaryPath));
+
+        auto lazy = manager.open_project_lazy(binaryPath.string());
+        REQUIRE(lazy != nullptr);
+        REQUIRE(lazy->assets_loaded());
+        REQUIRE(lazy->assets().size() == project.assets.size());
+
+        REQUIRE(manager.open_project_lazy((testDir / "lazy_missing.edx").string()) == nullptr);
+    }
+
+    SECTION("Malformed sections surface on first access")
+    {
+        auto brokenPath = testDir / "lazy_broken.edx";
+        {
+            std::ofstream file(brokenPath);
+            file << R"({"Assets": [{"id": 5}], "Project": {"name": "Broken"}})";
+        }
+
+        LazyEdxProject lazy;
+        REQUIRE(lazy.open(brokenPath));
+        REQUIRE(lazy.project().name == "Broken");
+        REQUIRE_THROWS(lazy.assets());
+    }
+}
+
+TEST_CASE("Parallel project loading", "[project][parallel]")
+{
+    using namespace EdxTests::ProjectFileComprehensiveTests;
+
+    auto testDir = std::filesystem::current_path() / "test_output";
+    std::filesystem::create_directories(testDir);
+
+    EdxProject project = CreateRealisticAirportProject();
+    project.settings["renderDistance"] = 50000;
+    for (int i = 0; i < 5; ++i)
+    {
+        SceneLayer layer;
+        layer.layerId = "extra_layer_" + std::to_string(i);
+        layer.name = "Extra " + std::to_string(i);
+        layer.assetIds = {"a", "b"};
+        project.layers.push_back(layer);
+    }
+
+    auto projectPath = testDir / "parallel_load_project.edx";
+    REQUIRE(project.save_to_file(projectPath));
+
+    json reference;
+    project.to_json(reference);
+
+    SECTION("Matches the serial load for any thread count")
+    {
+        for (unsigned int threads : {0u, 2u, 3u, 16u})
+        {
+            LoadOptions options;
+            options.threadCount = threads;
+
+            EdxProject loaded;
+            REQUIRE(loaded.load_from_file(projectPath, options));
+
+            json loadedJson;
+            loaded.to_json(loadedJson);
+            REQUIRE(loadedJson == reference);
+        }
+    }
+
+    SECTION("Errors and unusual layouts")
+    {
+        LoadOptions options;
+        options.threadCount = 4;
+
+        EdxProject target;
+        REQUIRE_THROWS_AS(target.from_json_buffer(R"({"Assets": [{"id": "a"}, {"id": 5}]})", options), std::exception);
+        REQUIRE_THROWS_AS(target.from_json_buffer(R"({"Assets": [{"id": "a"}], "Extra": [1, }})", options), json::parse_error);
+
+        // Not an object of sections: handled like the serial loader
+        target.from_json_buffer("[1, 2, 3]", options);
+        REQUIRE(target.assets.empty());
+
+        target.from_json_buffer(R"({"Assets": [{"id": "a"}, {"id": "b"}], "Layers": []})", options);
+        REQUIRE(target.assets.size() == 2);
+        REQUIRE(target.assets[1].id == "b");
+    }
+}
+
+TEST_CASE("Compressed project files", "[project][compression]")
+{
+    using namespace EdxTests::ProjectFileComprehensiveTests;
+
+    auto testDir = std::filesystem::current_path() / "test_output";
+    std::filesystem::create_directories(testDir);
+
+    EdxProject project = CreateRealisticAirportProject();
+    project.settings["renderDistance"] = 50000;
+
+    auto plainPath = testDir / "compressed_reference.edx";
+    auto compressedPath = testDir / "compressed_project.edx";
+    REQUIRE(project.save_to_file(plainPath));
+
+    json reference;
+    project.to_json(reference);
+
+    SaveOptions options;
+    options.compression = Compression::Zstd;
+
+    if (!is_compression_available())
+    {
+        REQUIRE_FALSE(project.save_to_file(compressedPath, options));
+        return;
+    }
+
+    SECTION("Round trip through every reader")
+    {
+        for (int level : {1, 3, 19})
+        {
+            options.compressionLevel = level;
+            REQUIRE(project.save_to_file(compressedPath, options));
+            REQUIRE(std::filesystem::file_size(compressedPath) < std::filesystem::file_size(plainPath));
+
+            EdxProject loaded;
+            REQUIRE(loaded.load_from_file(compressedPath));
+
+            json loadedJson;
+            loaded.to_json(loadedJson);
+            REQUIRE(loadedJson == reference);
+        }
+
+        auto header = ProjectFileHeader::probe(compressedPath);
+        REQUIRE(header.has_value());
+        REQUIRE(header->project.name == project.project.name);
+        REQUIRE(header->airport.icao == project.airport.icao);
+
+        LazyEdxProject lazy;
+        REQUIRE(lazy.open(compressedPath));
+        REQUIRE(lazy.assets_loaded());
+        REQUIRE(lazy.assets().size() == project.assets.size());
+    }
+
+    SECTION("Truncated data fails to load")
+    {
+        REQUIRE(project.save_to_file(compressedPath, options));
+
+        std::string data;
+        {
+            std::ifstream file(compressedPath, std::ios::binary);
+            data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        {
+            std::ofstream file(compressedPath, std::ios::binary | std::ios::trunc);
+            file.write(data.data(), static_cast<std::streamsize>(data.size() / 2));
+        }
+
+        EdxProject loaded;
+        REQUIRE_FALSE(loaded.load_from_file(compressedPath));
+    }
+}
+
+TEST_CASE("Asset lookup indexes", "[project][assets][index]")
+{
+    using namespace EdxTests::ProjectFileComprehensiveTests;
+
+    EdxProject project;
+    for (int i = 0; i < 100; ++i)
+    {
+        SceneAsset asset;
+        asset.id = "asset_" + std::to_string(i);
+        asset.uniqueId = "uid_" + std::to_string(i);
+        asset.latitude = i;
+        REQUIRE(project.insert_asset(asset) != nullptr);
+    }
+
+    SECTION("Find, insert and erase")
+    {
+        REQUIRE(project.find_asset("asset_42")->latitude == 42.0);
+        REQUIRE(project.find_asset_by_unique_id("uid_7")->id == "asset_7");
+        REQUIRE(project.find_asset("missing") == nullptr);
+        REQUIRE(project.find_asset("") == nullptr);
+
+        SceneAsset duplicate;
+        duplicate.id = "fresh";
+        duplicate.uniqueId = "uid_3";
+        REQUIRE(project.insert_asset(duplicate) == nullptr);
+        REQUIRE(project.assets.size() == 100);
+
+        // Erasing swaps the last asset into the hole
+        REQUIRE(project.erase_asset("asset_10"));
+        REQUIRE_FALSE(project.erase_asset("asset_10"));
+        REQUIRE(project.assets.size() == 99);
+        REQUIRE(project.assets[10].id == "asset_99");
+        REQUIRE(project.find_asset("asset_99") == &project.assets[10]);
+        REQUIRE(project.find_asset_by_unique_id("uid_10") == nullptr);
+
+        REQUIRE(project.erase_asset_by_unique_id("uid_98"));
+        REQUIRE(project.find_asset("asset_98") == nullptr);
+
+        for (const auto& asset : project.assets)
+        {
+            REQUIRE(project.find_asset(asset.id) == &asset);
+            REQUIRE(project.find_asset_by_unique_id(asset.uniqueId) == &asset);
+        }
+    }
+
+    SECTION("Direct edits to the asset vector")
+    {
+        const EdxProject& constProject = project;
+        REQUIRE(constProject.find_asset("asset_0") == &project.assets[0]);
+
+        std::swap(project.assets[0], project.assets[50]);
+        REQUIRE(project.find_asset("asset_0") == &project.assets[50]);
+
+        project.assets.erase(project.assets.begin());
+        REQUIRE(project.find_asset("asset_50") == nullptr);
+        REQUIRE(project.find_asset("asset_1") == &project.assets[0]);
+
+        project.assets[0].id = "renamed";
+        project.invalidate_asset_indexes();
+        REQUIRE(project.find_asset("renamed") == &project.assets[0]);
+    }
+
+    SECTION("Indexes follow a load")
+    {
+        EdxProject other = CreateRealisticAirportProject();
+        json otherJson;
+        other.to_json(otherJson);
+        std::string text = otherJson.dump();
+
+        REQUIRE(project.find_asset("asset_0") != nullptr);
+        project.from_json_buffer(text);
+        REQUIRE(project.find_asset("asset_0") == nullptr);
+        REQUIRE(project.find_asset(other.assets[0].id) == &project.assets[0]);
+
+        project.from_json(otherJson);
+        REQUIRE(project.find_asset(other.assets[1].id) == &project.assets[1]);
+    }
+
+    SECTION("Duplicate ids in loaded data resolve to the first asset")
+    {
+        project.assets.push_back(project.assets[5]);
+        REQUIRE(project.find_asset("asset_5") == &project.assets[5]);
+
+        REQUIRE(project.erase_asset("asset_5"));
+        REQUIRE(project.find_asset("asset_5") == &project.assets[5]);
+        REQUIRE(project.assets.size() == 100);
+    }
+}
+
+TEST_CASE("Interned asset reference fields", "[project][assets][intern]")
+{
+    using namespace EdxTests::ProjectFileComprehensiveTests;
+
+    SECTION("Equal text shares one handle")
+    {
+        const InternedString a = std::string("intern_test_layer");
+        const InternedString b = "intern_test_layer";
+        REQUIRE(a == b);
+        REQUIRE(a.c_str() == b.c_str());
+        REQUIRE(a == "intern_test_layer");
+        REQUIRE(a != InternedString("intern_test_other"));
+        REQUIRE(InternedString().empty());
+        REQUIRE(InternedString("") == InternedString());
+        REQUIRE(std::hash<InternedString>{}(a) == std::hash<InternedString>{}(b));
+    }
+
+    SECTION("Strings leave the pool with their last handle")
+    {
+        const size_t before = InternedString::pool_size();
+        {
+            InternedString first = "intern_test_released";
+            InternedString copy = first;
+            REQUIRE(InternedString::pool_size() == before + 1);
+
+            InternedString moved = std::move(first);
+            copy = InternedString();
+            REQUIRE(moved == "intern_test_released");
+            REQUIRE(InternedString::pool_size() == before + 1);
+        }
+        REQUIRE(InternedString::pool_size() == before);
+    }
+
+    SECTION("Loaded assets share their reference strings")
+    {
+        EdxProject project = CreateRealisticAirportProject();
+        json reference;
+        project.to_json(reference);
+
+        EdxProject loaded;
+        loaded.from_json_buffer(reference.dump());
+        REQUIRE(loaded.assets.size() == project.assets.size());
+        for (size_t i = 0; i < loaded.assets.size(); ++i)
+        {
+            REQUIRE(loaded.assets[i].associatedLibrary == project.assets[i].associatedLibrary);
+            REQUIRE(loaded.assets[i].layerId.c_str() == project.assets[i].layerId.c_str());
+        }
+
+        json loadedJson;
+        loaded.to_json(loadedJson);
+        REQUIRE(loadedJson.dump() == reference.dump());
+    }
+}
+
+TEST_CASE("Shared asset property blobs", "[project][assets][properties]")
+{
+    using namespace EdxTests::ProjectFileComprehensiveTests;
+
+    auto testDir = std::filesystem::current_path() / "test_output";
+    std::filesystem::create_directories(testDir);
+
+    // Few distinct blobs across many assets, as in real projects
+    EdxProject project = CreateRealisticAirportProject();
+    for (size_t i = 0; i < project.assets.size(); ++i)
+        project.assets[i].otherProperties = json{{"Object_Type", i % 3 == 0 ? "Hangar" : "Terminal"}};
+    project.assets[0].otherProperties = json();
+
+    json reference;
+    project.to_json(reference);
+
+    SECTION("Equal blobs share one tree and copy on write")
+    {
+        REQUIRE(project.share_properties() == 2);
+        SceneAsset& a = project.assets[3];
+        SceneAsset& b = project.assets[6];
+        REQUIRE(a.otherProperties.shares_with(b.otherProperties));
+
+        a.otherProperties["Object_Type"] = "Tower";
+        REQUIRE_FALSE(a.otherProperties.shares_with(b.otherProperties));
+        REQUIRE(b.otherProperties["Object_Type"] == "Hangar");
+        REQUIRE(a.otherProperties["Object_Type"] == "Tower");
+    }
+
+    SECTION("Loads share blobs on every path")
+    {
+        auto tablePath = testDir / "property_table_project.edx";
+        SaveOptions options;
+        options.propertyTable = true;
+        REQUIRE(project.save_to_file(tablePath, options));
+
+        std::ifstream file(tablePath);
+        const json written = json::parse(file);
+        REQUIRE(written["Property-Table"].size() == 2);
+        REQUIRE(written["Assets"][1].contains("other-properties-ref"));
+        REQUIRE_FALSE(written["Assets"][0].contains("other-properties-ref"));
+
+        for (unsigned int threads : {1u, 4u})
+        {
+            LoadOptions loadOptions;
+            loadOptions.threadCount = threads;
+
+            EdxProject loaded;
+            REQUIRE(loaded.load_from_file(tablePath, loadOptions));
+            REQUIRE(loaded.assets[3].otherProperties.shares_with(loaded.assets[6].otherProperties));
+
+            json loadedJson;
+            loaded.to_json(loadedJson);
+            REQUIRE(loadedJson == reference);
+        }
+
+        LazyEdxProject lazy;
+        REQUIRE(lazy.open(tablePath));
+        REQUIRE(lazy.assets()[3].otherProperties == project.assets[3].otherProperties);
+
+        auto binaryPath = testDir / "property_table_project.edxb";
+        REQUIRE(project.save_to_binary_file(binaryPath));
+        EdxProject binary;
+        REQUIRE(binary.load_from_binary_file(binaryPath));
+        REQUIRE(binary.assets[3].otherProperties.shares_with(binary.assets[6].otherProperties));
+        REQUIRE(binary.assets[0].otherProperties.is_null());
+
+        json binaryJson;
+        binary.to_json(binaryJson);
+        REQUIRE(binaryJson == reference);
+    }
+
+    SECTION("Bad references are rejected")
+    {
+        EdxProject target;
+        REQUIRE_THROWS_AS(target.from_json_buffer(R"({"Assets": [{"id": "a", "other-properties-ref": 0}]})"), std::exception);
+        REQUIRE_THROWS_AS(target.from_json_buffer(R"({"Assets": [{"id": "a", "other-properties-ref": 2}], "Property-Table": [{}]})"), std::exception);
+        REQUIRE(target.assets.empty());
+
+        // Refs outside the int range must not wrap onto a valid entry; the DOM path agrees
+        for (const char* ref : {"4294967296", "-2147483648", "9223372036854775808"})
+        {
+            const std::string text = std::string(R"({"Property-Table": [{}], "Assets": [{"id": "a", "other-properties-ref": )") + ref + "}]}";
+            REQUIRE_THROWS_AS(target.from_json_buffer(text), std::exception);
+            REQUIRE_THROWS_AS(target.from_json(json::parse(text)), std::exception);
+        }
+        REQUIRE(target.assets.empty());
+
+        target.from_json_buffer(R"({"Property-Table": [{"k": 1}], "Assets": [{"id": "a", "other-properties-ref": 0}]})");
+        REQUIRE(target.assets[0].otherProperties["k"] == 1);
+    }
+}
+
+TEST_CASE("Spatial asset ordering", "[project][assets][spatial]")
+{
+    using namespace EdxTests::ProjectFileComprehensiveTests;
+
+    auto testDir = std::filesystem::current_path() / "test_output";
+    std::filesystem::create_directories(testDir);
+
+    // Assets scattered over a grid in reverse row order
+    EdxProject project = CreateRealisticAirportProject();
+    project.assets.clear();
+    for (int i = 0; i < 64; ++i)
+    {
+        SceneAsset asset;
+        asset.id = "grid_" + std::to_string(i);
+        asset.uniqueId = UniqueId("grid-uid-" + std::to_string(i));
+        asset.latitude = 40.0 - (i / 8) * 0.01;
+        asset.longitude = -75.0 + (i % 8) * 0.01;
+        project.assets.push_back(asset);
+    }
+    project.layers[0].assetIds = {"grid_0", "grid_63", "grid_17"};
+
+    SECTION("Order is a permutation along increasing keys")
+    {
+        const std::vector<size_t> order = hilbert_order(project.assets);
+        REQUIRE(order.size() == project.assets.size());
+        REQUIRE(std::set<size_t>(order.begin(), order.end()).size() == order.size());
+
+        for (size_t i = 1; i < order.size(); ++i)
+        {
+            const SceneAsset& previous = project.assets[order[i - 1]];
+            const SceneAsset& current = project.assets[order[i]];
+            REQUIRE(hilbert_key(previous.latitude, previous.longitude) <= hilbert_key(current.latitude, current.longitude));
+        }
+
+        // Grid neighbours end up close together in the order
+        const auto position = [&](size_t asset) { return std::find(order.begin(), order.end(), asset) - order.begin(); };
+        REQUIRE(std::abs(position(0) - position(1)) < 8);
+    }
+
+    SECTION("In-memory sort keeps layers resolvable")
+    {
+        project.sort_assets_spatially();
+        REQUIRE(project.assets.size() == 64);
+        for (const auto& id : project.layers[0].assetIds)
+            REQUIRE(project.find_asset(id) != nullptr);
+
+        REQUIRE(project.find_asset("grid_17")->latitude == Catch::Approx(39.98));
+        REQUIRE(project.find_asset_by_unique_id(UniqueId("grid-uid-63"))->id == "grid_63");
+
+        for (size_t i = 1; i < project.assets.size(); ++i)
+        {
+            const SceneAsset& previous = project.assets[i - 1];
+            const SceneAsset& current = project.assets[i];
+            REQUIRE(hilbert_key(previous.latitude, previous.longitude) <= hilbert_key(current.latitude, current.longitude));
+        }
+    }
+
+    SECTION("Saving in spatial order leaves the project untouched")
+    {
+        SaveOptions options;
+        options.spatialOrder = true;
+
+        auto jsonPath = testDir / "spatial_project.edx";
+        auto binaryPath = testDir / "spatial_project.edxb";
+        REQUIRE(project.save_to_file(jsonPath, options));
+        REQUIRE(project.save_to_binary_file(binaryPath, options));
+        REQUIRE(project.assets[0].id == "grid_0");
+
+        project.sort_assets_spatially();
+        json reference;
+        project.to_json(reference);
+
+        EdxProject fromJson;
+        REQUIRE(fromJson.load_from_file(jsonPath));
+        json jsonLoaded;
+        fromJson.to_json(jsonLoaded);
+        REQUIRE(jsonLoaded == reference);
+
+        EdxProject fromBinary;
+        REQUIRE(fromBinary.load_from_binary_file(binaryPath));
+        json binaryLoaded;
+        fromBinary.to_json(binaryLoaded);
+        REQUIRE(binaryLoaded == reference);
+        REQUIRE(fromBinary.find_asset("grid_63") != nullptr);
+    }
+}